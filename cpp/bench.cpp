@@ -0,0 +1,48 @@
+#include "bench/gamehandler_bench.hxx"
+#include "bench/gamerecord_bench.hxx"
+#include "bench/gamestate_bench.hxx"
+#include "bench/ismcts_bench.hxx"
+#include "bench/topology_bench.hxx"
+#include "bench/vecgameenv_bench.hxx"
+
+#include "src/stats.hxx"
+
+/*
+	c++ -O3 -std=c++17 -pthread bench.cpp -o bench
+	add -DTURNCOAT_STATS to print what the engine counted over the whole run, which slows it down
+*/
+
+void print_stats(void)
+{
+	const auto stats = Turncoat::get_stats();
+	std::cout << "stats/games " << stats.get(Turncoat::GAMES) << std::endl;
+	std::cout << "stats/turns " << stats.get(Turncoat::TURNS) << std::endl;
+	std::cout << "stats/average_game_length " << std::setprecision(2) << stats.get_average_game_length() << std::endl;
+	std::cout << "stats/bag_draws " << stats.get(Turncoat::BAG_DRAWS) << std::endl;
+	std::cout << "stats/failed_attacks " << stats.get(Turncoat::FAILED_ATTACKS) << std::endl;
+	std::cout << "stats/failed_deploys " << stats.get(Turncoat::FAILED_DEPLOYS) << std::endl;
+	std::cout << "stats/failed_negociations " << stats.get(Turncoat::FAILED_NEGOCIATIONS) << std::endl;
+	std::cout << "stats/failed_rallies " << stats.get(Turncoat::FAILED_RALLIES) << std::endl;
+	std::cout << "stats/average_negociation_streak " << std::setprecision(2) << stats.get_average_negociation_streak() << std::endl;
+}
+
+void bench_all(void)
+{
+	bench_gamestate();
+	bench_topology();
+	bench_gamehandler();
+	bench_ismcts();
+	bench_gamerecord();
+	bench_vecgameenv();
+
+	if(Turncoat::STATS_ENABLED)
+	{
+		print_stats();
+	}
+}
+
+int main(void)
+{
+	bench_all();
+	return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef BENCH_HXX
+#define BENCH_HXX
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#ifndef private
+#define private public
+#endif // private
+
+#ifndef protected
+#define protected public
+#endif // protected
+
+#include "../constants/default_game.hxx"
+#include "../constants/default_map.hxx"
+
+// results are summed in here so that the compiler cannot drop the benchmarked work
+volatile uint64_t bench_sink = 0;
+
+// forces value to be read from memory again, so that work depending on it is not hoisted out of the benchmark loop
+template<typename T>
+inline void clobber(T &value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// runs fn(iteration_idx) nb_iterations times and prints the mean time per call, returns it in nanoseconds
+template<typename F>
+double bench(const std::string &name, const uint64_t nb_iterations, F &&fn)
+{
+	uint64_t checksum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t iteration_i = 0; iteration_i < nb_iterations; ++iteration_i)
+	{
+		checksum += fn(iteration_i);
+	}
+	const auto end = std::chrono::steady_clock::now();
+	bench_sink = bench_sink + checksum;
+
+	const double elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+	const double ns_per_iteration = elapsed_ns / nb_iterations;
+
+	std::cout << std::left << std::setw(48) << name
+		<< std::right << std::setw(12) << std::fixed << std::setprecision(2) << ns_per_iteration << " ns/op"
+		<< std::setw(16) << std::setprecision(0) << 1e9 / ns_per_iteration << " op/s"
+		<< std::endl;
+
+	return ns_per_iteration;
+}
+
+#endif // BENCH_HXX
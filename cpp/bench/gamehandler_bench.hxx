@@ -0,0 +1,115 @@
+#pragma once
+#ifndef GAMEHANDLER_BENCH_HXX
+#define GAMEHANDLER_BENCH_HXX
+
+#include <array>
+#include <functional>
+
+#include "bench.hxx"
+#include "../src/gamehandler.hxx"
+#include "../src/staticgamehandler.hxx"
+
+using namespace Turncoat;
+
+using DefaultGameHandlerType = GameHandler<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+using DefaultGameViewType = GameView<default_nb_hexagons, default_nb_factions, default_nb_hands>;
+using DefaultOrderType = Order<default_nb_hexagons, default_nb_factions, default_nb_per_faction>;
+
+inline uint8_t discard_first_possible(const std::array<uint8_t, default_nb_factions> &hand)
+{
+	for (uint8_t faction_i = 0; faction_i < hand.size(); ++faction_i)
+	{
+		if(hand[faction_i] > 0)
+		{
+			return faction_i;
+		}
+	}
+	return (uint8_t)hand.size();
+}
+
+// always_order_negociate and discard_first_possible, as a StaticGameHandler policy
+struct AlwaysNegociatePolicy
+{
+	template<typename GameStateViewType>
+	inline DefaultOrderType get_order(const GameStateViewType &)
+	{
+		return DefaultOrderType();
+	}
+
+	inline uint8_t pick_discarded_faction(const std::array<uint8_t, default_nb_factions> &hand)
+	{
+		return discard_first_possible(hand);
+	}
+};
+
+using AlwaysNegociateStaticGameHandlerType = UniformStaticGameHandler<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units,
+	AlwaysNegociatePolicy
+>;
+
+/*
+ * same games through both handlers, the turns only, games are set up outside of the timed part
+ * every turn is a negociation, so that what is measured is mostly the cost of calling the policies
+ */
+void bench_gamehandler_turns(void)
+{
+	constexpr uint64_t nb_games = 100000;
+
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+	fill_default_adjacency_graph(adjacency_graph);
+
+	const std::function<DefaultOrderType(const DefaultGameViewType)> always_order_negociate = (
+		[](const DefaultGameViewType){return DefaultOrderType();}
+	);
+	const std::function<uint8_t(const std::array<uint8_t, default_nb_factions>&)> discard_first_possible_function = (
+		discard_first_possible
+	);
+	std::array<std::function<DefaultOrderType(const DefaultGameViewType)>, default_nb_hands> order_getters;
+	std::array<std::function<uint8_t(const std::array<uint8_t, default_nb_factions>&)>, default_nb_hands> discarded_faction_pickers;
+	order_getters.fill(always_order_negociate);
+	discarded_faction_pickers.fill(discard_first_possible_function);
+
+	std::vector<DefaultGameHandlerType> function_handlers;
+	std::vector<AlwaysNegociateStaticGameHandlerType> static_handlers;
+	function_handlers.reserve(nb_games);
+	static_handlers.reserve(nb_games);
+	for (uint64_t game_i = 0; game_i < nb_games; ++game_i)
+	{
+		function_handlers.emplace_back(
+			&adjacency_graph,
+			&default_factions_starting_point,
+			&default_unreachable_hexagons,
+			game_i,
+			order_getters,
+			discarded_faction_pickers
+		);
+		static_handlers.emplace_back(default_board_topology, &default_factions_starting_point, game_i, AlwaysNegociateStaticGameHandlerType::PoliciesType{});
+	}
+
+	const auto function_ns = bench("gamehandler/negociate_turn/std_function", nb_games * default_nb_hands, [&function_handlers](uint64_t turn_i){
+		return (uint64_t)function_handlers[turn_i / default_nb_hands].run_turn();
+	});
+	const auto static_ns = bench("gamehandler/negociate_turn/static", nb_games * default_nb_hands, [&static_handlers](uint64_t turn_i){
+		return (uint64_t)static_handlers[turn_i / default_nb_hands].run_turn();
+	});
+	std::cout << "gamehandler/negociate_turn speedup " << std::setprecision(2) << function_ns / static_ns << "x" << std::endl;
+}
+
+void bench_gamehandler(void)
+{
+	bench_gamehandler_turns();
+}
+
+#endif // GAMEHANDLER_BENCH_HXX
@@ -0,0 +1,93 @@
+#pragma once
+#ifndef GAMERECORD_BENCH_HXX
+#define GAMERECORD_BENCH_HXX
+
+#include <array>
+#include <cstdio>
+#include <string>
+
+#include "bench.hxx"
+#include "gamestate_bench.hxx"
+#include "../src/gamerecord.hxx"
+
+using namespace Turncoat;
+
+using BenchGameRecordWriterType = GameRecordWriter<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+using BenchGameRecordReaderType = GameRecordReader<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+// plays game_idx to the end, recording it if game_record_writer is given, returns the number of turns
+uint64_t play_bench_random_game(const uint64_t game_idx, BenchGameRecordWriterType *game_record_writer)
+{
+	static DefaultBenchGame::GameStateType::MoveBuffer moves;
+	uint64_t nb_orders = 0;
+	auto handler = DefaultBenchGame::make_random_handler(default_board_topology, default_factions_starting_point, game_idx, moves, nb_orders);
+	if(game_record_writer != nullptr)
+	{
+		handler.start_recording(*game_record_writer);
+	}
+
+	handler.run_all_turns();
+	return nb_orders;
+}
+
+/*
+ * the cost of recording on top of playing, then of reading back
+ * the file is written to /tmp, so what is measured is mostly the page cache rather than the disk
+ */
+void bench_gamerecord_throughput(void)
+{
+	constexpr uint64_t nb_games = 20000;
+	const std::string path = "/tmp/turncoat_gamerecord_bench.bin";
+
+	bench("gamerecord/play_game/no_record", nb_games, [](uint64_t game_i){
+		return play_bench_random_game(game_i, nullptr);
+	});
+	{
+		BenchGameRecordWriterType game_record_writer(path, default_board_topology, default_factions_starting_point, false);
+		bench("gamerecord/play_game/record", nb_games, [&game_record_writer](uint64_t game_i){
+			return play_bench_random_game(game_i, &game_record_writer);
+		});
+	}
+	{
+		BenchGameRecordWriterType game_record_writer(path, default_board_topology, default_factions_starting_point, true);
+		bench("gamerecord/play_game/record_observations", nb_games, [&game_record_writer](uint64_t game_i){
+			return play_bench_random_game(game_i, &game_record_writer);
+		});
+	}
+
+	const BenchGameRecordReaderType game_record_reader(path);
+	const uint64_t nb_steps = game_record_reader.get_nb_steps(0);
+	bench("gamerecord/get_steps", nb_games, [&game_record_reader](uint64_t game_i){
+		return (uint64_t)game_record_reader.get_steps(game_i).size();
+	});
+	bench("gamerecord/get_observations", nb_games, [&game_record_reader](uint64_t game_i){
+		return (uint64_t)game_record_reader.get_observations(game_i)[0];
+	});
+	bench("gamerecord/replay", nb_games, [&game_record_reader](uint64_t game_i){
+		return game_record_reader.replay(game_i).get_hash();
+	});
+	std::cout << "gamerecord/file " << game_record_reader.size / nb_games << " bytes/game, first game has " << nb_steps << " steps" << std::endl;
+
+	std::remove(path.c_str());
+}
+
+void bench_gamerecord(void)
+{
+	bench_gamerecord_throughput();
+}
+
+#endif // GAMERECORD_BENCH_HXX
@@ -0,0 +1,334 @@
+#pragma once
+#ifndef GAMESTATE_BENCH_HXX
+#define GAMESTATE_BENCH_HXX
+
+#include <array>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "bench.hxx"
+#include "../src/gamestate.hxx"
+#include "../src/gamestateview.hxx"
+#include "../src/random.hxx"
+#include "../src/staticgamehandler.hxx"
+#include "../src/topology.hxx"
+
+using namespace Turncoat;
+
+// the types and maps the benchmarks play with, for any game size
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_PLAYERS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+struct BenchGame
+{
+	using GameStateType = GameState<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using GameStateViewType = GameStateView<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using OrderType = Order<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION>;
+	using MoveCodec = typename GameStateType::CorrespondingMoveCodec;
+	using Topology = typename GameStateType::CorrespondingBoardTopology;
+	using StartingPoints = std::array<uint8_t, NB_FACTIONS>;
+
+	/*
+	 * uniformly random legal orders, every order therefore succeeds and nb_orders counts the turns
+	 * the move buffer is shared, it gets large on bigger maps and only one policy plays at a time
+	 */
+	struct RandomLegalPolicy
+	{
+		SplitMix64 random_generator;
+		typename GameStateType::MoveBuffer *moves;
+		uint64_t *nb_orders;
+
+		inline OrderType get_order(const GameStateViewType &game_state_view)
+		{
+			++(*this->nb_orders);
+			const auto nb_moves = game_state_view.generate_legal_moves(*this->moves);
+			return MoveCodec::decode(
+				(nb_moves == 0) ? MoveCodec::encode_negociate() : (*this->moves)[this->random_generator.uniform(nb_moves)]
+			);
+		}
+
+		inline uint8_t pick_discarded_faction(const std::array<uint8_t, NB_FACTIONS> &hand)
+		{
+			return discard_first_in(hand);
+		}
+	};
+
+	using RandomStaticGameHandlerType = UniformStaticGameHandler<
+		NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS,
+		RandomLegalPolicy
+	>;
+
+	static inline uint8_t discard_first_in(const std::array<uint8_t, NB_FACTIONS> &hand)
+	{
+		for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
+		{
+			if(hand[faction_i] > 0)
+			{
+				return faction_i;
+			}
+		}
+		return NB_FACTIONS;
+	}
+
+	static RandomStaticGameHandlerType make_random_handler(
+		const Topology &topology,
+		const std::array<uint8_t, NB_FACTIONS> &factions_starting_point,
+		const uint64_t seed,
+		typename GameStateType::MoveBuffer &moves,
+		uint64_t &nb_orders
+	)
+	{
+		typename RandomStaticGameHandlerType::PoliciesType policies;
+		set_policies(policies, seed, moves, nb_orders, std::make_index_sequence<NB_PLAYERS>{});
+		return RandomStaticGameHandlerType(topology, &factions_starting_point, seed, policies);
+	}
+
+	template<size_t... SEAT_IDXS>
+	static void set_policies(
+		typename RandomStaticGameHandlerType::PoliciesType &policies,
+		const uint64_t seed,
+		typename GameStateType::MoveBuffer &moves,
+		uint64_t &nb_orders,
+		std::index_sequence<SEAT_IDXS...>
+	)
+	{
+		((std::get<SEAT_IDXS>(policies) = RandomLegalPolicy{SplitMix64{seed}.split(SEAT_IDXS), &moves, &nb_orders}), ...);
+	}
+
+	// a triangular lattice, rows of width hexagons each linked to the next one and to the two below it, like a hex grid
+	static constexpr Topology make_lattice_topology(const uint8_t width)
+	{
+		auto out = Topology::empty();
+		for (uint8_t hexagon_i = 0; hexagon_i < NB_HEXAGONS; ++hexagon_i)
+		{
+			const bool is_last_of_row = (hexagon_i % width == width - 1);
+			if(!is_last_of_row && hexagon_i + 1 < NB_HEXAGONS)
+			{
+				out.add_edge(hexagon_i, hexagon_i + 1);
+			}
+			if(hexagon_i + width < NB_HEXAGONS)
+			{
+				out.add_edge(hexagon_i, hexagon_i + width);
+			}
+			if(!is_last_of_row && hexagon_i + width + 1 < NB_HEXAGONS)
+			{
+				out.add_edge(hexagon_i, hexagon_i + width + 1);
+			}
+		}
+		return out;
+	}
+
+	static constexpr std::array<uint8_t, NB_FACTIONS> make_spread_starting_points(void)
+	{
+		std::array<uint8_t, NB_FACTIONS> out{};
+		for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
+		{
+			out[faction_i] = (uint8_t)((uint32_t)faction_i * NB_HEXAGONS / NB_FACTIONS);
+		}
+		return out;
+	}
+};
+
+using DefaultBenchGame = BenchGame<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+inline void print_rate(const std::string &name, const double count, const double elapsed_ns, const std::string &unit)
+{
+	std::cout << std::left << std::setw(48) << name
+		<< std::right << std::setw(12) << std::fixed << std::setprecision(2) << elapsed_ns / count << " ns/" << unit
+		<< std::setw(14) << std::setprecision(0) << count * 1e9 / elapsed_ns << " " << unit << "/s"
+		<< std::endl;
+}
+
+// full games through StaticGameHandler::run_all_turns with random legal policies, setup included
+template<typename Game>
+void bench_playouts(
+	const std::string &name,
+	const typename Game::Topology &topology,
+	const typename Game::StartingPoints &factions_starting_point,
+	const uint64_t nb_games
+)
+{
+	auto moves = std::make_unique<typename Game::GameStateType::MoveBuffer>();
+	uint64_t nb_orders = 0;
+	const auto ns_per_game = bench(name + "/games", nb_games, [&](uint64_t game_i){
+		auto handler = Game::make_random_handler(topology, factions_starting_point, game_i, *moves, nb_orders);
+		handler.run_all_turns();
+		return (uint64_t)handler.get_winner();
+	});
+	print_rate(name + "/moves", nb_orders, ns_per_game * nb_games, "move");
+}
+
+/*
+ * states in the middle of random games, each with one legal order of the wanted type for the hand to play
+ * each benchmarked call gets its own state, so that no state has to be restored in the timed part
+ */
+struct PreparedOrder
+{
+	DefaultBenchGame::GameStateType game_state;
+	uint8_t hand_idx;
+	MoveId move;
+};
+
+std::vector<PreparedOrder> prepare_orders(const OrderType order_type, const uint64_t nb_orders)
+{
+	std::vector<PreparedOrder> out;
+	out.reserve(nb_orders);
+
+	DefaultBenchGame::GameStateType::MoveBuffer moves;
+	std::vector<MoveId> matching_moves;
+	for (uint64_t seed = 0; out.size() < nb_orders; ++seed)
+	{
+		auto game_state = DefaultBenchGame::GameStateType(default_board_topology, &default_factions_starting_point, seed);
+		SplitMix64 random_generator{seed};
+
+		uint8_t hand_idx = 0;
+		while(game_state.get_successive_negociation_counter() < default_nb_hands && out.size() < nb_orders)
+		{
+			const auto nb_moves = game_state.generate_legal_moves(hand_idx, moves);
+			if(nb_moves == 0)
+			{
+				break;
+			}
+
+			matching_moves.clear();
+			for (MoveId move_i = 0; move_i < nb_moves; ++move_i)
+			{
+				if(DefaultBenchGame::MoveCodec::decode(moves[move_i]).order_type == order_type)
+				{
+					matching_moves.push_back(moves[move_i]);
+				}
+			}
+			if(!matching_moves.empty())
+			{
+				out.push_back(PreparedOrder{
+					game_state,
+					hand_idx,
+					matching_moves[random_generator.uniform(matching_moves.size())]
+				});
+			}
+
+			game_state.make_move(hand_idx, moves[random_generator.uniform(nb_moves)], DefaultBenchGame::discard_first_in);
+			++hand_idx;
+			hand_idx *= (hand_idx < default_nb_hands);
+		}
+	}
+	return out;
+}
+
+/*
+ * per call latency of the checked orders and of what they are built on, on the default map
+ * orders are decoded from their MoveId in the timed part, as callers holding a move would have to
+ */
+void bench_gamestate_operations(void)
+{
+	constexpr uint64_t nb_calls = 200000;
+
+	auto attacks = prepare_orders(ATTACK, nb_calls);
+	bench("gamestate/attack", nb_calls, [&attacks](uint64_t call_i){
+		auto &prepared = attacks[call_i];
+		const auto order = DefaultBenchGame::MoveCodec::decode(prepared.move);
+		return (uint64_t)prepared.game_state.attack(
+			prepared.hand_idx,
+			order.atking_faction_idx,
+			order.atked_faction_idx,
+			order.nb_atked_units,
+			order.hexagon_idx
+		);
+	});
+
+	auto rallies = prepare_orders(RALLY, nb_calls);
+	bench("gamestate/rally", nb_calls, [&rallies](uint64_t call_i){
+		auto &prepared = rallies[call_i];
+		const auto order = DefaultBenchGame::MoveCodec::decode(prepared.move);
+		return (uint64_t)prepared.game_state.rally(
+			prepared.hand_idx,
+			order.faction_idx,
+			order.nb_units,
+			order.start_hexagon_idx,
+			order.end_hexagon_idx
+		);
+	});
+
+	auto negociations = prepare_orders(NEGOCIATE, nb_calls);
+	bench("gamestate/negociate", nb_calls, [&negociations](uint64_t call_i){
+		auto &prepared = negociations[call_i];
+		return (uint64_t)prepared.game_state.negociate(prepared.hand_idx, DefaultBenchGame::discard_first_in);
+	});
+
+	// negociations left the bag as they found it, so it is not empty either
+	bench("gamestate/draw_random_from_bag", nb_calls, [&negociations](uint64_t call_i){
+		return (uint64_t)negociations[call_i].game_state.draw_random_from_bag();
+	});
+
+	// on finished games, as it would be called, the first call per state only since the winner is kept afterwards
+	std::vector<DefaultBenchGame::GameStateType> finished_game_states;
+	finished_game_states.reserve(nb_calls);
+	DefaultBenchGame::GameStateType::MoveBuffer moves;
+	for (uint64_t game_i = 0; game_i < nb_calls; ++game_i)
+	{
+		uint64_t nb_orders = 0;
+		auto handler = DefaultBenchGame::make_random_handler(default_board_topology, default_factions_starting_point, game_i, moves, nb_orders);
+		handler.run_all_turns();
+		finished_game_states.push_back(handler.get_game_state());
+	}
+	bench("gamestate/get_winning_hand", nb_calls, [&finished_game_states](uint64_t call_i){
+		return (uint64_t)finished_game_states[call_i].get_winning_hand();
+	});
+}
+
+void bench_gamestate_playouts(void)
+{
+	bench_playouts<DefaultBenchGame>("gamestate/playout/default", default_board_topology, default_factions_starting_point, 50000);
+}
+
+// the same playouts on larger games than the default one, on generated maps
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_PLAYERS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+void bench_scaled_playouts(const uint8_t width, const uint64_t nb_games)
+{
+	using Game = BenchGame<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	const std::string name = (
+		"gamestate/playout/" + std::to_string(NB_HEXAGONS) + "h_" + std::to_string(NB_FACTIONS) + "f_" + std::to_string(NB_PLAYERS) + "p"
+	);
+	bench_playouts<Game>(name, Game::make_lattice_topology(width), Game::make_spread_starting_points(), nb_games);
+}
+
+void bench_gamestate_scaling(void)
+{
+	bench_scaled_playouts<default_nb_hexagons, default_nb_factions, default_nb_per_faction, default_nb_hands, default_nb_per_hand, default_nb_starting_units>(4, 50000);
+	bench_scaled_playouts<24, 4, 21, 4, 8, 2>(6, 20000);
+	bench_scaled_playouts<32, 5, 24, 6, 6, 2>(8, 10000);
+	bench_scaled_playouts<48, 6, 30, 8, 6, 2>(8, 5000);
+	bench_scaled_playouts<64, 8, 30, 8, 8, 2>(8, 2000);
+}
+
+void bench_gamestate(void)
+{
+	bench_gamestate_playouts();
+	bench_gamestate_operations();
+	bench_gamestate_scaling();
+}
+
+#endif // GAMESTATE_BENCH_HXX
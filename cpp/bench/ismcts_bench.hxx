@@ -0,0 +1,65 @@
+#pragma once
+#ifndef ISMCTS_BENCH_HXX
+#define ISMCTS_BENCH_HXX
+
+#include <array>
+#include <thread>
+
+#include "bench.hxx"
+#include "../src/ismcts.hxx"
+
+using namespace Turncoat;
+
+using DefaultISMCTSType = ISMCTS<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+// a search from the first move of a game, each iteration being one sample, one tree walk and one playout
+void bench_ismcts_search(const uint32_t nb_threads)
+{
+	constexpr uint32_t nb_iterations = 2000;
+	constexpr uint64_t nb_searches = 10;
+
+	const auto game_state = DefaultISMCTSType::CorrespondingGameStateType(default_board_topology, &default_factions_starting_point, (uint64_t)0);
+	std::array<uint8_t, default_nb_hands> hand_sizes;
+	hand_sizes.fill(default_nb_per_hand);
+	const DefaultISMCTSType::CorrespondingGameViewType game_view(
+		game_state.get_attack_zone(),
+		game_state.get_rally_zone(),
+		game_state.get_hands()[0],
+		game_state.get_hexagons(),
+		hand_sizes,
+		0,
+		0
+	);
+
+	ISMCTSConfig config;
+	config.nb_iterations = nb_iterations;
+	config.nb_threads = nb_threads;
+	DefaultISMCTSType searcher(default_board_topology, default_factions_starting_point, config);
+
+	const auto ns_per_search = bench(
+		"ismcts/search/" + std::to_string(nb_iterations) + "_iterations/" + std::to_string(nb_threads) + "_threads",
+		nb_searches,
+		[&searcher, &game_view](uint64_t){
+			return (uint64_t)searcher.search(game_view);
+		}
+	);
+	std::cout << "ismcts/search " << std::setprecision(0) << nb_iterations * 1e9 / ns_per_search << " iterations/s" << std::endl;
+}
+
+void bench_ismcts(void)
+{
+	bench_ismcts_search(1);
+	if(std::thread::hardware_concurrency() > 1)
+	{
+		bench_ismcts_search(std::thread::hardware_concurrency());
+	}
+}
+
+#endif // ISMCTS_BENCH_HXX
@@ -0,0 +1,131 @@
+#pragma once
+#ifndef TOPOLOGY_BENCH_HXX
+#define TOPOLOGY_BENCH_HXX
+
+#include <algorithm>
+#include <array>
+#include <unordered_set>
+
+#include "bench.hxx"
+#include "../src/gamestate.hxx"
+
+using namespace Turncoat;
+
+using DefaultGameStateType = GameState<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+// checks as GameState did them before BoardTopology, through pointers to a bool matrix and an unordered_set
+struct LegacyTopology
+{
+	const std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> *adjacency_graph;
+	const std::unordered_set<uint8_t> *unreachable_hexagons;
+
+	inline bool is_reachable(const uint8_t hexagon_idx) const
+	{
+		return (
+			std::find(
+				this->unreachable_hexagons->begin(),
+				this->unreachable_hexagons->end(),
+				hexagon_idx
+			) == this->unreachable_hexagons->end()
+		);
+	}
+
+	inline bool are_adjacent(const uint8_t first_hexagon_idx, const uint8_t second_hexagon_idx) const
+	{
+		return (*(this->adjacency_graph))[first_hexagon_idx][second_hexagon_idx];
+	}
+};
+
+// the topology part of can_rally for every (start, end) pair of the board
+template<typename Topology>
+uint64_t count_valid_rally_paths(const Topology &topology)
+{
+	uint64_t out = 0;
+	for (uint8_t start_hexagon_i = 0; start_hexagon_i < default_nb_hexagons; ++start_hexagon_i)
+	{
+		for (uint8_t end_hexagon_i = 0; end_hexagon_i < default_nb_hexagons; ++end_hexagon_i)
+		{
+			out += (
+				topology.is_reachable(start_hexagon_i)
+				&& topology.is_reachable(end_hexagon_i)
+				&& topology.are_adjacent(start_hexagon_i, end_hexagon_i)
+			);
+		}
+	}
+	return out;
+}
+
+void bench_topology_checks(void)
+{
+	constexpr uint64_t nb_iterations = 1000000;
+
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+	fill_default_adjacency_graph(adjacency_graph);
+	const LegacyTopology legacy{&adjacency_graph, &default_unreachable_hexagons};
+
+	// a runtime copy, as held by game states
+	auto topology = default_board_topology;
+
+	const auto legacy_ns = bench("topology/rally_paths/legacy", nb_iterations, [&legacy](uint64_t){
+		clobber(legacy);
+		return count_valid_rally_paths(legacy);
+	});
+	const auto bitmask_ns = bench("topology/rally_paths/bitmask", nb_iterations, [&topology](uint64_t){
+		clobber(topology);
+		return count_valid_rally_paths(topology);
+	});
+	std::cout << "topology/rally_paths speedup " << std::setprecision(2) << legacy_ns / bitmask_ns << "x" << std::endl;
+}
+
+// what rollouts pay per move: listing the legal moves then playing one
+void bench_topology_rollouts(void)
+{
+	constexpr uint64_t nb_games = 20000;
+	const std::array<uint8_t, default_nb_factions> factions_starting_point = default_factions_starting_point;
+
+	uint64_t nb_moves_played = 0;
+	DefaultGameStateType::MoveBuffer moves;
+	const auto ns_per_game = bench("topology/random_rollout", nb_games, [&](uint64_t game_i){
+		auto game_state = DefaultGameStateType(default_board_topology, &factions_starting_point, game_i);
+		SplitMix64 random_generator{game_i};
+
+		uint8_t hand_idx = 0;
+		while(game_state.get_successive_negociation_counter() < default_nb_hands)
+		{
+			const auto nb_moves = game_state.generate_legal_moves(hand_idx, moves);
+			if(nb_moves == 0)
+			{
+				break;
+			}
+
+			game_state.make_move(
+				hand_idx,
+				moves[random_generator.uniform(nb_moves)],
+				[](const std::array<uint8_t, default_nb_factions> &hand){
+					return (uint8_t)(std::find_if(hand.begin(), hand.end(), [](uint8_t n){return n > 0;}) - hand.begin());
+				}
+			);
+			++nb_moves_played;
+
+			++hand_idx;
+			hand_idx *= (hand_idx < default_nb_hands);
+		}
+		return (uint64_t)game_state.get_winning_hand();
+	});
+	std::cout << "topology/random_rollout " << std::setprecision(2) << ns_per_game * nb_games / nb_moves_played << " ns/move" << std::endl;
+}
+
+void bench_topology(void)
+{
+	bench_topology_checks();
+	bench_topology_rollouts();
+}
+
+#endif // TOPOLOGY_BENCH_HXX
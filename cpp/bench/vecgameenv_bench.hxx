@@ -0,0 +1,128 @@
+#pragma once
+#ifndef VECGAMEENV_BENCH_HXX
+#define VECGAMEENV_BENCH_HXX
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.hxx"
+#include "gamestate_bench.hxx"
+#include "../src/vecgameenv.hxx"
+
+using namespace Turncoat;
+
+using BenchVecGameEnvType = VecGameEnv<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+/*
+ * VecGameEnv::step against nb_envs GameStates stepped one by one, random legal actions in both
+ * only the stepping is timed: picking actions from the legal action lists is what the caller does either way
+ * the env also writes observations, and splits a negociation in two steps, the second one without generating moves
+ * writing the dense masks is timed on its own, as callers which only sample from legal_actions never pay for it
+ */
+void bench_vecgameenv_against_scalar(const uint32_t nb_envs, const uint32_t nb_steps)
+{
+	const std::string name = "vecgameenv/" + std::to_string(nb_envs) + "_envs";
+
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+	fill_default_adjacency_graph(adjacency_graph);
+	std::vector<uint64_t> seeds(nb_envs);
+	for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+	{
+		seeds[env_i] = env_i;
+	}
+
+	{
+		BenchVecGameEnvType env(nb_envs, seeds, adjacency_graph, default_factions_starting_point, default_unreachable_hexagons);
+		std::vector<uint32_t> actions(nb_envs);
+		SplitMix64 random_generator{0};
+		double elapsed_ns = 0;
+		double masks_elapsed_ns = 0;
+		uint64_t nb_written_masks = 0;
+
+		for (uint32_t step_i = 0; step_i < nb_steps; ++step_i)
+		{
+			for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+			{
+				actions[env_i] = env.legal_actions[env_i][random_generator.uniform(env.nb_legal_actions[env_i])];
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			bench_sink = bench_sink + env.step(actions.data());
+			const auto stepped = std::chrono::steady_clock::now();
+			nb_written_masks += env.write_legal_action_masks();
+			const auto end = std::chrono::steady_clock::now();
+
+			elapsed_ns += std::chrono::duration<double, std::nano>(stepped - start).count();
+			masks_elapsed_ns += std::chrono::duration<double, std::nano>(end - stepped).count();
+		}
+		print_rate(name + "/step", (double)nb_envs * nb_steps, elapsed_ns, "env_step");
+		print_rate(name + "/write_legal_action_masks", (double)nb_written_masks, masks_elapsed_ns, "mask");
+	}
+
+	{
+		std::vector<DefaultBenchGame::GameStateType> game_states;
+		game_states.reserve(nb_envs);
+		for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+		{
+			game_states.emplace_back(default_board_topology, &default_factions_starting_point, seeds[env_i]);
+		}
+		std::vector<uint8_t> current_player_idx(nb_envs, 0);
+		auto moves = std::make_unique<DefaultBenchGame::GameStateType::MoveBuffer[]>(nb_envs);
+		std::vector<MoveId> nb_moves(nb_envs);
+		for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+		{
+			nb_moves[env_i] = game_states[env_i].generate_legal_moves(0, moves[env_i]);
+		}
+
+		std::vector<MoveId> actions(nb_envs);
+		SplitMix64 random_generator{0};
+		double elapsed_ns = 0;
+
+		for (uint32_t step_i = 0; step_i < nb_steps; ++step_i)
+		{
+			for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+			{
+				actions[env_i] = moves[env_i][random_generator.uniform(nb_moves[env_i])];
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+			{
+				auto &game_state = game_states[env_i];
+				game_state.make_move(current_player_idx[env_i], actions[env_i], DefaultBenchGame::discard_first_in);
+				if(game_state.get_successive_negociation_counter() == default_nb_hands)
+				{
+					bench_sink = bench_sink + game_state.get_winning_hand();
+					game_state = DefaultBenchGame::GameStateType(default_board_topology, &default_factions_starting_point, seeds[env_i] + step_i);
+					current_player_idx[env_i] = 0;
+				}
+				else
+				{
+					++current_player_idx[env_i];
+					current_player_idx[env_i] *= (current_player_idx[env_i] < default_nb_hands);
+				}
+				nb_moves[env_i] = game_state.generate_legal_moves(current_player_idx[env_i], moves[env_i]);
+			}
+			elapsed_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		}
+		print_rate(name + "/scalar_gamestates", (double)nb_envs * nb_steps, elapsed_ns, "env_step");
+	}
+}
+
+void bench_vecgameenv(void)
+{
+	bench_vecgameenv_against_scalar(16, 2000);
+	bench_vecgameenv_against_scalar(256, 500);
+}
+
+#endif // VECGAMEENV_BENCH_HXX
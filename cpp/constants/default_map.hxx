@@ -0,0 +1,85 @@
+#pragma once
+#ifndef DEFAULT_MAP_HXX
+#define DEFAULT_MAP_HXX
+
+#include <array>
+#include <cstdint>
+#include <unordered_set>
+
+#include "./default_game.hxx"
+
+#include "../src/topology.hxx"
+
+const std::array<uint8_t, default_nb_factions> default_factions_starting_point = {{2, 6, 11}};
+const std::unordered_set<uint8_t> default_unreachable_hexagons{7};
+
+void fill_default_adjacency_graph(
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons>& adjacency_graph
+)
+{
+	for (auto hexagon_ite = adjacency_graph.begin(); hexagon_ite != adjacency_graph.end(); ++hexagon_ite)
+	{
+		hexagon_ite->fill(false);
+	}
+
+	adjacency_graph[0][1] = true;
+	adjacency_graph[0][3] = true;
+	adjacency_graph[0][4] = true;
+
+	adjacency_graph[1][0] = true;
+	adjacency_graph[1][2] = true;
+	adjacency_graph[1][4] = true;
+
+	adjacency_graph[2][1] = true;
+	adjacency_graph[2][4] = true;
+	adjacency_graph[2][5] = true;
+
+	adjacency_graph[3][0] = true;
+	adjacency_graph[3][4] = true;
+	adjacency_graph[3][6] = true;
+
+	adjacency_graph[4][0] = true;
+	adjacency_graph[4][1] = true;
+	adjacency_graph[4][2] = true;
+	adjacency_graph[4][3] = true;
+	adjacency_graph[4][5] = true;
+
+	adjacency_graph[5][2] = true;
+	adjacency_graph[5][4] = true;
+	adjacency_graph[5][8] = true;
+
+	adjacency_graph[6][3] = true;
+	adjacency_graph[6][9] = true;
+
+	adjacency_graph[8][5] = true;
+	adjacency_graph[8][9] = true;
+	adjacency_graph[8][11] = true;
+
+	adjacency_graph[9][6] = true;
+	adjacency_graph[9][8] = true;
+	adjacency_graph[9][10] = true;
+
+	adjacency_graph[10][9] = true;
+	adjacency_graph[10][11] = true;
+
+	adjacency_graph[11][8] = true;
+	adjacency_graph[11][10] = true;
+}
+
+// same map as fill_default_adjacency_graph, built at compile time
+constexpr auto default_board_topology = Turncoat::BoardTopology<default_nb_hexagons>::from_edges(
+	std::array<std::pair<uint8_t, uint8_t>, 16>{{
+		{0, 1}, {0, 3}, {0, 4},
+		{1, 2}, {1, 4},
+		{2, 4}, {2, 5},
+		{3, 4}, {3, 6},
+		{4, 5},
+		{5, 8},
+		{6, 9},
+		{8, 9}, {8, 11},
+		{9, 10}, {10, 11},
+	}},
+	Turncoat::BoardTopology<default_nb_hexagons>::to_mask(7)
+);
+
+#endif // DEFAULT_MAP_HXX
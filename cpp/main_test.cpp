@@ -1,10 +1,24 @@
+#include "test/gamerecord_test.hxx"
 #include "test/gamestate_test.hxx"
 #include "test/gamehandler_test.hxx"
+#include "test/ismcts_test.hxx"
+#include "test/selfplay_test.hxx"
+#include "test/staticgamehandler_test.hxx"
+#include "test/stats_test.hxx"
+#include "test/transposition_table_test.hxx"
+#include "test/vecgameenv_test.hxx"
 
 void test_all(void)
 {
 	test_gamestate();
 	test_gamehandler();
+	test_transposition_table();
+	test_vecgameenv();
+	test_selfplay();
+	test_ismcts();
+	test_staticgamehandler();
+	test_gamerecord();
+	test_stats();
 }
 
 int main(int argc, char const *argv[])
@@ -1,12 +1,21 @@
 #include <pybind11/pybind11.h>
 
 #include "./pybind/gamehandler_pybind.hxx"
+#include "./pybind/gamerecord_pybind.hxx"
+#include "./pybind/selfplay_pybind.hxx"
+#include "./pybind/stats_pybind.hxx"
+#include "./pybind/vecgameenv_pybind.hxx"
 
 /*
-	c++ -O3 -Wall -shared -std=c++11 -fPIC $(python3 -m pybind11 --includes) pybind.cpp -o turncoat$(python3-config --extension-suffix)
+	c++ -O3 -Wall -shared -std=c++17 -pthread -fPIC $(python3 -m pybind11 --includes) pybind.cpp -o turncoat$(python3-config --extension-suffix)
+	add -DTURNCOAT_STATS for turncoat.get_stats() to count
 */
 
 PYBIND11_MODULE(turncoat, m) {
     m.doc() = "Turncoat game engine package by Arcanite bound from C++ using Pybind11"; // optional module docstring
     gamehandler_pybind(m);
+    vecgameenv_pybind(m);
+    selfplay_pybind(m);
+    gamerecord_pybind(m);
+    stats_pybind(m);
 }
@@ -24,7 +24,7 @@ using DefaultGameHandlerType = Turncoat::GameHandler<
 >;
 
 using DefaultOrderType = Turncoat::Order<default_nb_hexagons, default_nb_factions, default_nb_per_faction>;
-using DefaultGameViewType = Turncoat::GameView<default_nb_hexagons, default_nb_factions>;
+using DefaultGameViewType = Turncoat::GameView<default_nb_hexagons, default_nb_factions, default_nb_hands>;
 
 void gamehandler_pybind(py::module &m) {
 	py::class_<DefaultGameHandlerType>(m, "DefaultGameHandler")
@@ -46,9 +46,16 @@ void gamehandler_pybind(py::module &m) {
 			default_nb_hands
 		>
 	>())
-	.def("run_turn", &DefaultGameHandlerType::run_turn)
-	.def("run_all_turns", &DefaultGameHandlerType::run_all_turns)
-	.def("get_winner", &DefaultGameHandlerType::get_winner);
+	// the methods come from StaticGameHandler, which is not bound itself
+	.def("run_turn", py::method_adaptor<DefaultGameHandlerType>(&DefaultGameHandlerType::run_turn))
+	.def("run_all_turns", py::method_adaptor<DefaultGameHandlerType>(&DefaultGameHandlerType::run_all_turns))
+	.def("get_winner", py::method_adaptor<DefaultGameHandlerType>(&DefaultGameHandlerType::get_winner))
+	.def(
+		"start_recording",
+		py::method_adaptor<DefaultGameHandlerType>(&DefaultGameHandlerType::start_recording),
+		py::keep_alive<1, 2>(),
+		"records the game in a DefaultGameRecordWriter from now on, to be called before the first turn"
+	);
 }
 
 #endif // GAMEHANDLER_PYBIND_HXX
@@ -0,0 +1,115 @@
+#pragma once
+#ifndef GAMERECORD_PYBIND_HXX
+#define GAMERECORD_PYBIND_HXX
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <array>
+#include <string>
+#include <unordered_set>
+
+#include "../constants/default_game.hxx"
+
+#include "../src/gamerecord.hxx"
+
+namespace py = pybind11;
+
+using DefaultGameRecordWriterType = Turncoat::GameRecordWriter<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+using DefaultGameRecordReaderType = Turncoat::GameRecordReader<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+void gamerecord_pybind(py::module &m) {
+	// games are added to it by DefaultGameHandler.start_recording
+	py::class_<DefaultGameRecordWriterType>(m, "DefaultGameRecordWriter")
+	.def(
+		py::init([](
+			const std::string &path,
+			const std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> &adjacency_graph,
+			const std::array<uint8_t, default_nb_factions> &factions_starting_point,
+			const std::unordered_set<uint8_t> &unreachable_hexagons,
+			const bool with_observations
+		){
+			return new DefaultGameRecordWriterType(
+				path,
+				DefaultGameRecordWriterType::CorrespondingBoardTopology::from_adjacency_graph(adjacency_graph, unreachable_hexagons),
+				factions_starting_point,
+				with_observations
+			);
+		}),
+		py::arg("path"),
+		py::arg("adjacency_graph"),
+		py::arg("factions_starting_point"),
+		py::arg("unreachable_hexagons"),
+		py::arg("with_observations") = false
+	)
+	.def_property_readonly("nb_games", &DefaultGameRecordWriterType::get_nb_games)
+	.def_property_readonly("has_observations", &DefaultGameRecordWriterType::has_observations)
+	.def("close", &DefaultGameRecordWriterType::close, "writes the footer, a game still in progress is dropped")
+	.def("__enter__", [](py::object self){return self;})
+	.def("__exit__", [](DefaultGameRecordWriterType &writer, py::args){writer.close();});
+
+	py::class_<DefaultGameRecordReaderType>(m, "DefaultGameRecordReader")
+	.def(py::init<const std::string &>())
+	.def_property_readonly("nb_games", &DefaultGameRecordReaderType::get_nb_games)
+	.def_property_readonly("has_observations", &DefaultGameRecordReaderType::has_observations)
+	.def("get_seed", &DefaultGameRecordReaderType::get_seed)
+	.def("get_nb_steps", &DefaultGameRecordReaderType::get_nb_steps)
+	.def(
+		"get_steps",
+		[](const DefaultGameRecordReaderType &reader, const uint64_t game_idx)
+		{
+			const auto steps = reader.get_steps(game_idx);
+			py::array_t<uint8_t> hand_idxs(steps.size());
+			py::array_t<uint32_t> moves(steps.size());
+			py::array_t<uint8_t> discarded_faction_idxs(steps.size());
+			for (size_t step_i = 0; step_i < steps.size(); ++step_i)
+			{
+				hand_idxs.mutable_at(step_i) = steps[step_i].hand_idx;
+				moves.mutable_at(step_i) = steps[step_i].move;
+				discarded_faction_idxs.mutable_at(step_i) = steps[step_i].discarded_faction_idx;
+			}
+			return py::make_tuple(hand_idxs, moves, discarded_faction_idxs);
+		},
+		"hand index, move and discarded faction (for negociations) of every step of a game"
+	)
+	.def(
+		"get_observations",
+		[](py::object self, const uint64_t game_idx) -> py::object
+		{
+			const auto &reader = self.cast<const DefaultGameRecordReaderType&>();
+			const uint8_t *observations = reader.get_observations(game_idx);
+			if(observations == nullptr)
+			{
+				return py::none();
+			}
+
+			// read only, the mapping it points into is
+			py::array_t<uint8_t> out(
+				{(py::ssize_t)reader.get_nb_steps(game_idx), (py::ssize_t)DefaultGameRecordReaderType::CorrespondingFormat::OBS_SIZE},
+				observations,
+				self
+			);
+			out.attr("flags").attr("writeable") = false;
+			return out;
+		},
+		"observations before every step of a game, shared with the file mapping, None if the file has none"
+	);
+}
+
+#endif // GAMERECORD_PYBIND_HXX
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef SELFPLAY_PYBIND_HXX
+#define SELFPLAY_PYBIND_HXX
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <string>
+#include <vector>
+
+#include "../constants/default_game.hxx"
+#include "../constants/default_map.hxx"
+
+#include "../src/selfplay.hxx"
+
+namespace py = pybind11;
+
+using DefaultSelfPlayRunnerType = Turncoat::SelfPlayRunner<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+void selfplay_pybind(py::module &m) {
+	py::class_<Turncoat::PolicyResult>(m, "PolicyResult")
+	.def_readonly("name", &Turncoat::PolicyResult::name)
+	.def_readonly("nb_games", &Turncoat::PolicyResult::nb_games)
+	.def_readonly("nb_seats", &Turncoat::PolicyResult::nb_seats)
+	.def_readonly("nb_wins", &Turncoat::PolicyResult::nb_wins)
+	.def_property_readonly("win_rate", &Turncoat::PolicyResult::get_win_rate)
+	.def("get_confidence_interval", &Turncoat::PolicyResult::get_confidence_interval, py::arg("z") = 1.96);
+
+	py::class_<Turncoat::SelfPlayResults>(m, "SelfPlayResults")
+	.def_readonly("nb_games", &Turncoat::SelfPlayResults::nb_games)
+	.def_readonly("nb_turns", &Turncoat::SelfPlayResults::nb_turns)
+	.def_readonly("policies", &Turncoat::SelfPlayResults::policies);
+
+	m.def(
+		"run_default_selfplay",
+		[](const uint64_t nb_games, const uint64_t master_seed, const uint32_t nb_threads, const std::vector<std::string> &policy_names)
+		{
+			std::vector<DefaultSelfPlayRunnerType::Policy> policies;
+			for (const auto &policy_name : policy_names)
+			{
+				policies.push_back(DefaultSelfPlayRunnerType::get_builtin_policy(policy_name));
+			}
+
+			std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+			fill_default_adjacency_graph(adjacency_graph);
+
+			py::gil_scoped_release release;
+			const DefaultSelfPlayRunnerType runner(
+				adjacency_graph,
+				default_factions_starting_point,
+				default_unreachable_hexagons,
+				policies
+			);
+			return runner.run(nb_games, master_seed, nb_threads);
+		},
+		py::arg("nb_games"),
+		py::arg("master_seed") = 0,
+		py::arg("nb_threads") = 0,
+		py::arg("policy_names") = std::vector<std::string>{"random", "negociate"},
+		"plays nb_games games of the default map between builtin policies on nb_threads threads (0 for all cores), without holding the GIL"
+	);
+}
+
+#endif // SELFPLAY_PYBIND_HXX
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef STATS_PYBIND_HXX
+#define STATS_PYBIND_HXX
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "../src/stats.hxx"
+
+namespace py = pybind11;
+
+void stats_pybind(py::module &m) {
+	py::class_<Turncoat::Stats>(m, "Stats")
+	.def_property_readonly("nb_games", [](const Turncoat::Stats &stats){return stats.get(Turncoat::GAMES);})
+	.def_property_readonly("nb_turns", [](const Turncoat::Stats &stats){return stats.get(Turncoat::TURNS);})
+	.def_property_readonly("nb_bag_draws", [](const Turncoat::Stats &stats){return stats.get(Turncoat::BAG_DRAWS);})
+	.def_property_readonly("nb_failed_attacks", [](const Turncoat::Stats &stats){return stats.get(Turncoat::FAILED_ATTACKS);})
+	.def_property_readonly("nb_failed_deploys", [](const Turncoat::Stats &stats){return stats.get(Turncoat::FAILED_DEPLOYS);})
+	.def_property_readonly("nb_failed_negociations", [](const Turncoat::Stats &stats){return stats.get(Turncoat::FAILED_NEGOCIATIONS);})
+	.def_property_readonly("nb_failed_rallies", [](const Turncoat::Stats &stats){return stats.get(Turncoat::FAILED_RALLIES);})
+	.def_readonly("negociation_streaks", &Turncoat::Stats::negociation_streaks)
+	.def_property_readonly("average_game_length", &Turncoat::Stats::get_average_game_length)
+	.def_property_readonly("average_negociation_streak", &Turncoat::Stats::get_average_negociation_streak);
+
+	m.attr("stats_enabled") = Turncoat::STATS_ENABLED;
+	m.def("get_stats", &Turncoat::get_stats, "what the engine counted on every thread, all zero unless built with -DTURNCOAT_STATS");
+	m.def("reset_stats", &Turncoat::reset_stats);
+}
+
+#endif // STATS_PYBIND_HXX
@@ -0,0 +1,117 @@
+#pragma once
+#ifndef VECGAMEENV_PYBIND_HXX
+#define VECGAMEENV_PYBIND_HXX
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <vector>
+
+#include "../constants/default_game.hxx"
+
+#include "../src/vecgameenv.hxx"
+
+namespace py = pybind11;
+
+using DefaultVecGameEnvType = Turncoat::VecGameEnv<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+// numpy array sharing the buffer of a VecGameEnv, which stays alive as long as the array does
+template<typename T>
+py::array_t<T> as_shared_array(std::vector<T> &buffer, const std::vector<py::ssize_t> &shape, py::object owner)
+{
+	return py::array_t<T>(shape, buffer.data(), owner);
+}
+
+void vecgameenv_pybind(py::module &m) {
+	py::class_<DefaultVecGameEnvType>(m, "DefaultVecGameEnv")
+	.def(py::init<
+		const uint32_t,
+		const std::vector<uint64_t> &,
+		const std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> &,
+		const std::array<uint8_t, default_nb_factions> &,
+		const std::unordered_set<uint8_t> &
+	>())
+	.def_property_readonly_static("nb_actions", [](py::object){return DefaultVecGameEnvType::NB_ACTIONS;})
+	.def_property_readonly_static("obs_size", [](py::object){return DefaultVecGameEnvType::OBS_SIZE;})
+	.def_readonly("nb_envs", &DefaultVecGameEnvType::nb_envs)
+	.def("reset", &DefaultVecGameEnvType::reset)
+	.def(
+		"step",
+		[](DefaultVecGameEnvType &env, py::array_t<uint32_t, py::array::c_style | py::array::forcecast> actions)
+		{
+			if(actions.ndim() != 1 || actions.shape(0) != env.nb_envs)
+			{
+				throw py::value_error("expected one action per env");
+			}
+
+			const uint32_t *raw_actions = actions.data();
+			py::gil_scoped_release release;
+			return env.step(raw_actions);
+		},
+		"plays one action per env, returns the number of illegal (ignored) actions"
+	)
+	.def_property_readonly("observations", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.observations, {(py::ssize_t)env.nb_envs, DefaultVecGameEnvType::OBS_SIZE}, self);
+	})
+	.def_property_readonly_static("max_legal_actions", [](py::object){return DefaultVecGameEnvType::MAX_LEGAL_ACTIONS;})
+	.def_property_readonly("legal_actions", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return py::array_t<Turncoat::MoveId>(
+			{(py::ssize_t)env.nb_envs, (py::ssize_t)DefaultVecGameEnvType::MAX_LEGAL_ACTIONS},
+			env.legal_actions.data()->data(),
+			self
+		);
+	}, "legal_actions[i, :nb_legal_actions[i]] are the legal actions of env i, the rest is left over from previous steps")
+	.def_property_readonly("nb_legal_actions", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.nb_legal_actions, {(py::ssize_t)env.nb_envs}, self);
+	})
+	.def_property_readonly("legal_action_masks", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		env.write_legal_action_masks();
+		return as_shared_array(env.legal_action_masks, {(py::ssize_t)env.nb_envs, DefaultVecGameEnvType::NB_ACTIONS}, self);
+	}, "written when read, for the envs stepped or reset since it was last read: read it again after every step")
+	.def_property_readonly("rewards", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.rewards, {(py::ssize_t)env.nb_envs, default_nb_hands}, self);
+	})
+	.def_property_readonly("dones", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.dones, {(py::ssize_t)env.nb_envs}, self);
+	})
+	.def_property_readonly("hexagons", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.hexagons, {(py::ssize_t)env.nb_envs, default_nb_hexagons, default_nb_factions}, self);
+	})
+	.def_property_readonly("hands", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.hands, {(py::ssize_t)env.nb_envs, default_nb_hands, default_nb_factions}, self);
+	})
+	.def_property_readonly("bag", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.bag, {(py::ssize_t)env.nb_envs, default_nb_factions}, self);
+	})
+	.def_property_readonly("attack_zone", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.attack_zone, {(py::ssize_t)env.nb_envs, default_nb_factions}, self);
+	})
+	.def_property_readonly("rally_zone", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.rally_zone, {(py::ssize_t)env.nb_envs, default_nb_factions}, self);
+	})
+	.def_property_readonly("current_player_idx", [](py::object self){
+		auto &env = self.cast<DefaultVecGameEnvType&>();
+		return as_shared_array(env.current_player_idx, {(py::ssize_t)env.nb_envs}, self);
+	});
+}
+
+#endif // VECGAMEENV_PYBIND_HXX
@@ -0,0 +1,80 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "./constants/default_game.hxx"
+#include "./constants/default_map.hxx"
+
+#include "./src/selfplay.hxx"
+
+/*
+	c++ -O3 -Wall -std=c++17 -pthread selfplay.cpp -o selfplay
+	./selfplay [nb_games] [master_seed] [nb_threads] [policy...]
+*/
+
+using DefaultSelfPlayRunnerType = Turncoat::SelfPlayRunner<
+	default_nb_hexagons,
+	default_nb_factions,
+	default_nb_per_faction,
+	default_nb_hands,
+	default_nb_per_hand,
+	default_nb_starting_units
+>;
+
+int main(int argc, char const *argv[])
+{
+	const uint64_t nb_games = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	const uint64_t master_seed = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 0;
+	const uint32_t nb_threads = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 0;
+
+	std::vector<DefaultSelfPlayRunnerType::Policy> policies;
+	for (int arg_i = 4; arg_i < argc; ++arg_i)
+	{
+		try
+		{
+			policies.push_back(DefaultSelfPlayRunnerType::get_builtin_policy(argv[arg_i]));
+		}
+		catch(const std::invalid_argument &error)
+		{
+			std::cerr << error.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	if(policies.empty())
+	{
+		policies = DefaultSelfPlayRunnerType::get_builtin_policies();
+	}
+
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+	fill_default_adjacency_graph(adjacency_graph);
+
+	const DefaultSelfPlayRunnerType runner(
+		adjacency_graph,
+		default_factions_starting_point,
+		default_unreachable_hexagons,
+		policies
+	);
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto results = runner.run(nb_games, master_seed, nb_threads);
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << results.nb_games << " games, " << results.nb_turns << " turns in " << elapsed.count() << "s ("
+		<< results.nb_games / elapsed.count() << " games/s)" << std::endl;
+
+	// the interval is taken over games, as seats of the same game are not independent
+	for (const auto &policy : results.policies)
+	{
+		const auto confidence_interval = policy.get_confidence_interval();
+		std::cout << std::setw(12) << policy.name
+			<< "\twin rate " << std::fixed << std::setprecision(4) << policy.get_win_rate()
+			<< "\t95% CI [" << confidence_interval[0] << ", " << confidence_interval[1] << "]"
+			<< "\t(" << policy.nb_wins << " / " << policy.nb_seats << " seats, " << policy.nb_games << " games)" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,663 @@
+#pragma once
+#ifndef GAMERECORD_HXX
+#define GAMERECORD_HXX
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./gamestate.hxx"
+#include "./gamestateview.hxx"
+#include "./move.hxx"
+#include "./observation.hxx"
+#include "./topology.hxx"
+#include "./util.hxx"
+
+namespace Turncoat
+{
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "game records are written in host order, which is expected to be little endian");
+
+// LEB128: 7 bits per byte, high bit set on every byte but the last
+inline uint8_t *write_varint(uint64_t value, uint8_t *out)
+{
+	while(value >= 0x80)
+	{
+		*(out++) = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	*(out++) = (uint8_t)value;
+	return out;
+}
+
+// returns nullptr if the varint does not end before end
+inline const uint8_t *read_varint(const uint8_t *in, const uint8_t *end, uint64_t &value)
+{
+	value = 0;
+	for (uint8_t shift = 0; in < end && shift < 64; shift += 7)
+	{
+		const uint8_t byte = *(in++);
+		value |= (uint64_t)(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+		{
+			return in;
+		}
+	}
+	return nullptr;
+}
+
+/*
+ * file layout, every integer little endian:
+ *
+ * header
+ * 	magic u64, version u16, flags u16 (bit 0: observations), the 6 template parameters u8 each, observation size u32,
+ * 	neighbors masks u64 * NB_HEXAGONS, reachable mask u64, factions starting points u8 * NB_FACTIONS
+ * games, one after the other
+ * 	seed u64, nb_steps u32, nb_token_bytes u32, tokens, then nb_steps observations if the file has them
+ * footer
+ * 	offset of every game u64 * nb_games, nb_games u64, magic u64
+ *
+ * a step is one order which changed the game: a varint token, which is
+ * 	the discarded faction for a negociation (NB_FACTIONS if the discard failed, which still used the generator)
+ * 	move + NB_FACTIONS for anything else
+ * orders which failed without touching the game are not recorded, a failed negociation does not pass the turn
+ * observations are the ones VecGameEnv gives, of the hand about to play, taken before the step
+ * replaying the steps over the state built from the map and the seed gives back every state of the game
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_HANDS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+struct GameRecordFormat
+{
+	using CorrespondingGameStateType = GameState<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingGameStateViewType = GameStateView<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingObservationLayout = ObservationLayout<NB_HEXAGONS, NB_FACTIONS, NB_HANDS>;
+	using CorrespondingMoveCodec = typename CorrespondingGameStateType::CorrespondingMoveCodec;
+	using CorrespondingBoardTopology = typename CorrespondingGameStateType::CorrespondingBoardTopology;
+
+	static constexpr uint64_t MAGIC = 0x4452434552435454ULL; // "TTCRECRD"
+	static constexpr uint16_t VERSION = 1;
+	static constexpr uint16_t HAS_OBSERVATIONS_FLAG = 1;
+
+	static constexpr uint32_t OBS_SIZE = CorrespondingObservationLayout::SIZE;
+
+	static constexpr size_t HEADER_SIZE = 8 + 2 + 2 + 6 + 4 + 8 * (size_t)NB_HEXAGONS + 8 + NB_FACTIONS;
+	static constexpr size_t GAME_HEADER_SIZE = 8 + 4 + 4;
+	static constexpr size_t FOOTER_TAIL_SIZE = 8 + 8;
+	static constexpr size_t MAX_TOKEN_SIZE = 5;
+
+	static_assert(CorrespondingMoveCodec::encode_negociate() == 0, "tokens rely on the negociation being move 0");
+
+	static inline uint64_t to_token(const MoveId move, const uint8_t discarded_faction_idx)
+	{
+		return (move == CorrespondingMoveCodec::encode_negociate()) ? discarded_faction_idx : (uint64_t)move + NB_FACTIONS;
+	}
+
+	// a step which does not pass the turn, the only kind of failed order which is recorded
+	static inline bool is_failed_negociation(const uint64_t token)
+	{
+		return token == NB_FACTIONS;
+	}
+
+	static inline MoveId to_move(const uint64_t token)
+	{
+		return (token <= NB_FACTIONS) ? CorrespondingMoveCodec::encode_negociate() : (MoveId)(token - NB_FACTIONS);
+	}
+
+	// only meaningful for negociations
+	static inline uint8_t to_discarded_faction(const uint64_t token)
+	{
+		return (uint8_t)token;
+	}
+
+	static void write_observation(const CorrespondingGameStateViewType &game_state_view, uint8_t *out)
+	{
+		::memcpy(out + CorrespondingObservationLayout::HEXAGONS_OFFSET, &game_state_view.get_hexagons(), NB_HEXAGONS * NB_FACTIONS);
+		::memcpy(out + CorrespondingObservationLayout::HAND_OFFSET, &game_state_view.get_hand(), NB_FACTIONS);
+		::memcpy(out + CorrespondingObservationLayout::ATTACK_ZONE_OFFSET, &game_state_view.get_attack_zone(), NB_FACTIONS);
+		::memcpy(out + CorrespondingObservationLayout::RALLY_ZONE_OFFSET, &game_state_view.get_rally_zone(), NB_FACTIONS);
+		for (uint8_t hand_i = 0; hand_i < NB_HANDS; ++hand_i)
+		{
+			out[CorrespondingObservationLayout::HAND_SIZES_OFFSET + hand_i] = game_state_view.get_hand_size(hand_i);
+		}
+		out[CorrespondingObservationLayout::PLAYER_OFFSET] = game_state_view.get_hand_idx();
+		out[CorrespondingObservationLayout::NEGOCIATION_COUNTER_OFFSET] = game_state_view.get_successive_negociation_counter();
+		out[CorrespondingObservationLayout::PENDING_DISCARD_OFFSET] = 0;
+	}
+};
+
+/*
+ * appends games to a file through a buffer, so that the disk only sees large writes
+ * a game is kept in memory until end_game, then goes to the buffer as a whole
+ * close (or the destructor) writes the footer, without which readers refuse the file
+ * I/O errors once the file is open panic, a half written dataset is not worth going on for, and the destructor could not throw them
+ * failing to open the file and misuse throw, so that bindings can report them
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_HANDS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+class GameRecordWriter
+{
+public:
+	using CorrespondingFormat = GameRecordFormat<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingGameStateViewType = typename CorrespondingFormat::CorrespondingGameStateViewType;
+	using CorrespondingBoardTopology = typename CorrespondingFormat::CorrespondingBoardTopology;
+
+protected:
+	FILE *file;
+	const bool with_observations;
+
+	std::vector<uint8_t> buffer;
+	size_t buffer_size;
+	uint64_t file_offset; // of the beginning of buffer
+
+	std::vector<uint64_t> game_offsets;
+
+	// current game
+	bool is_in_game;
+	uint64_t game_seed;
+	uint32_t game_nb_steps;
+	std::vector<uint8_t> game_tokens;
+	std::vector<uint8_t> game_observations;
+
+	void flush(void)
+	{
+		if(this->buffer_size > 0 && ::fwrite(this->buffer.data(), 1, this->buffer_size, this->file) != this->buffer_size)
+		{
+			panic("[GameRecordWriter.flush]\tCould not write to file");
+		}
+		this->file_offset += this->buffer_size;
+		this->buffer_size = 0;
+	}
+
+	void write(const void *data, const size_t size)
+	{
+		// empty vectors may hand out nullptr, which memcpy does not take
+		if(size == 0)
+		{
+			return;
+		}
+
+		if(this->buffer_size + size > this->buffer.size())
+		{
+			this->flush();
+		}
+
+		// bigger than the whole buffer, straight to the file
+		if(size > this->buffer.size())
+		{
+			if(::fwrite(data, 1, size, this->file) != size)
+			{
+				panic("[GameRecordWriter.write]\tCould not write to file");
+			}
+			this->file_offset += size;
+			return;
+		}
+
+		::memcpy(this->buffer.data() + this->buffer_size, data, size);
+		this->buffer_size += size;
+	}
+
+	template<typename T>
+	inline void write_value(const T value)
+	{
+		this->write(&value, sizeof(value));
+	}
+
+	void write_header(const CorrespondingBoardTopology &topology, const std::array<uint8_t, NB_FACTIONS> &factions_starting_point)
+	{
+		this->write_value<uint64_t>(CorrespondingFormat::MAGIC);
+		this->write_value<uint16_t>(CorrespondingFormat::VERSION);
+		this->write_value<uint16_t>(this->with_observations ? CorrespondingFormat::HAS_OBSERVATIONS_FLAG : 0);
+		const std::array<uint8_t, 6> parameters = {{
+			NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS
+		}};
+		this->write(parameters.data(), parameters.size());
+		this->write_value<uint32_t>(CorrespondingFormat::OBS_SIZE);
+		for (const auto neighbors : topology.neighbors)
+		{
+			this->write_value<uint64_t>(neighbors);
+		}
+		this->write_value<uint64_t>(topology.reachable);
+		this->write(factions_starting_point.data(), NB_FACTIONS);
+	}
+
+public:
+	GameRecordWriter(
+		const std::string &path,
+		const CorrespondingBoardTopology &topology,
+		const std::array<uint8_t, NB_FACTIONS> &factions_starting_point,
+		const bool with_observations,
+		const size_t buffer_capacity = 1 << 20
+	):
+	file(::fopen(path.c_str(), "wb")),
+	with_observations(with_observations),
+	buffer(buffer_capacity),
+	buffer_size(0),
+	file_offset(0),
+	is_in_game(false),
+	game_seed(0),
+	game_nb_steps(0)
+	{
+		if(this->file == nullptr)
+		{
+			throw std::runtime_error("[GameRecordWriter]\tCould not open " + path);
+		}
+		this->write_header(topology, factions_starting_point);
+	}
+
+	GameRecordWriter(const GameRecordWriter&) = delete;
+	GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+
+	~GameRecordWriter()
+	{
+		this->close();
+	}
+
+	inline bool has_observations(void) const
+	{
+		return this->with_observations;
+	}
+
+	inline uint64_t get_nb_games(void) const
+	{
+		return this->game_offsets.size();
+	}
+
+	void begin_game(const uint64_t seed)
+	{
+		if(this->file == nullptr)
+		{
+			throw std::logic_error("[GameRecordWriter.begin_game]\tWriter is closed");
+		}
+		if(this->is_in_game)
+		{
+			throw std::logic_error("[GameRecordWriter.begin_game]\tPrevious game was not ended");
+		}
+		this->is_in_game = true;
+		this->game_seed = seed;
+		this->game_nb_steps = 0;
+		this->game_tokens.clear();
+		this->game_observations.clear();
+	}
+
+	// observation is read only if the file has observations, see GameRecordFormat::write_observation
+	void add_step(const MoveId move, const uint8_t discarded_faction_idx, const uint8_t *observation)
+	{
+		std::array<uint8_t, CorrespondingFormat::MAX_TOKEN_SIZE> token;
+		uint8_t *token_end = write_varint(CorrespondingFormat::to_token(move, discarded_faction_idx), token.data());
+		this->game_tokens.insert(this->game_tokens.end(), token.data(), token_end);
+
+		if(this->with_observations)
+		{
+			this->game_observations.insert(this->game_observations.end(), observation, observation + CorrespondingFormat::OBS_SIZE);
+		}
+		++(this->game_nb_steps);
+	}
+
+	void end_game(void)
+	{
+		if(!this->is_in_game)
+		{
+			throw std::logic_error("[GameRecordWriter.end_game]\tNo game to end");
+		}
+		this->is_in_game = false;
+
+		this->game_offsets.push_back(this->file_offset + this->buffer_size);
+		this->write_value<uint64_t>(this->game_seed);
+		this->write_value<uint32_t>(this->game_nb_steps);
+		this->write_value<uint32_t>(this->game_tokens.size());
+		this->write(this->game_tokens.data(), this->game_tokens.size());
+		this->write(this->game_observations.data(), this->game_observations.size());
+	}
+
+	// a game still in progress is dropped
+	void close(void)
+	{
+		if(this->file == nullptr)
+		{
+			return;
+		}
+
+		this->write(this->game_offsets.data(), this->game_offsets.size() * sizeof(uint64_t));
+		this->write_value<uint64_t>(this->game_offsets.size());
+		this->write_value<uint64_t>(CorrespondingFormat::MAGIC);
+		this->flush();
+
+		if(::fclose(this->file) != 0)
+		{
+			panic("[GameRecordWriter.close]\tCould not close file");
+		}
+		this->file = nullptr;
+		this->is_in_game = false;
+	}
+};
+
+/*
+ * random access to the games of a record file, mapped in memory rather than read
+ * tokens and observations are handed out as pointers into the mapping, valid as long as the reader
+ * files which cannot be read throw std::runtime_error, game indices past the end std::out_of_range
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_HANDS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+class GameRecordReader
+{
+public:
+	using CorrespondingFormat = GameRecordFormat<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingGameStateType = typename CorrespondingFormat::CorrespondingGameStateType;
+	using CorrespondingMoveCodec = typename CorrespondingFormat::CorrespondingMoveCodec;
+	using CorrespondingBoardTopology = typename CorrespondingFormat::CorrespondingBoardTopology;
+
+	struct Step
+	{
+		uint8_t hand_idx;
+		MoveId move;
+		uint8_t discarded_faction_idx; // negociation only, NB_FACTIONS if it failed
+	};
+
+protected:
+	const uint8_t *data;
+	size_t size;
+
+	bool with_observations;
+	CorrespondingBoardTopology topology;
+	std::array<uint8_t, NB_FACTIONS> factions_starting_point;
+
+	const uint8_t *game_offsets; // u64 * nb_games, unaligned
+	uint64_t nb_games;
+
+	template<typename T>
+	inline T read_value(const size_t offset) const
+	{
+		// offset may come from a corrupted file, offset + sizeof(T) could wrap around
+		if(offset > this->size || sizeof(T) > this->size - offset)
+		{
+			throw std::runtime_error("[GameRecordReader]\tRead past the end of the file");
+		}
+		T out;
+		::memcpy(&out, this->data + offset, sizeof(T));
+		return out;
+	}
+
+	void read_header(void)
+	{
+		if(this->read_value<uint64_t>(0) != CorrespondingFormat::MAGIC)
+		{
+			throw std::runtime_error("[GameRecordReader]\tNot a game record file");
+		}
+		if(this->read_value<uint16_t>(8) != CorrespondingFormat::VERSION)
+		{
+			throw std::runtime_error("[GameRecordReader]\tUnsupported game record version");
+		}
+		this->with_observations = this->read_value<uint16_t>(10) & CorrespondingFormat::HAS_OBSERVATIONS_FLAG;
+
+		const std::array<uint8_t, 6> parameters = this->read_value<std::array<uint8_t, 6>>(12);
+		const std::array<uint8_t, 6> expected_parameters = {{
+			NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS
+		}};
+		if(parameters != expected_parameters || this->read_value<uint32_t>(18) != CorrespondingFormat::OBS_SIZE)
+		{
+			throw std::runtime_error("[GameRecordReader]\tGame record was written for other game parameters");
+		}
+
+		size_t offset = 22;
+		for (auto &neighbors : this->topology.neighbors)
+		{
+			neighbors = this->read_value<uint64_t>(offset);
+			offset += 8;
+		}
+		this->topology.reachable = this->read_value<uint64_t>(offset);
+		offset += 8;
+		this->factions_starting_point = this->read_value<std::array<uint8_t, NB_FACTIONS>>(offset);
+	}
+
+	void read_footer(void)
+	{
+		if(
+			this->size < CorrespondingFormat::HEADER_SIZE + CorrespondingFormat::FOOTER_TAIL_SIZE
+			|| this->read_value<uint64_t>(this->size - 8) != CorrespondingFormat::MAGIC
+		)
+		{
+			throw std::runtime_error("[GameRecordReader]\tGame record has no footer, it was not closed");
+		}
+
+		// checked against the file size before being multiplied, a corrupted count could overflow the index size
+		this->nb_games = this->read_value<uint64_t>(this->size - CorrespondingFormat::FOOTER_TAIL_SIZE);
+		if(this->nb_games > (this->size - CorrespondingFormat::HEADER_SIZE - CorrespondingFormat::FOOTER_TAIL_SIZE) / sizeof(uint64_t))
+		{
+			throw std::runtime_error("[GameRecordReader]\tGame record index does not fit in the file");
+		}
+		this->game_offsets = this->data + this->size - CorrespondingFormat::FOOTER_TAIL_SIZE - this->nb_games * sizeof(uint64_t);
+	}
+
+	inline size_t get_game_offset(const uint64_t game_idx) const
+	{
+		if(game_idx >= this->nb_games)
+		{
+			throw std::out_of_range("[GameRecordReader]\tNo such game");
+		}
+		uint64_t out;
+		::memcpy(&out, this->game_offsets + game_idx * sizeof(uint64_t), sizeof(out));
+		// past this check, the offsets computed from the game header fit in a size_t
+		if(out > this->size - CorrespondingFormat::GAME_HEADER_SIZE)
+		{
+			throw std::runtime_error("[GameRecordReader]\tGame offset past the end of the file");
+		}
+		return out;
+	}
+
+public:
+	explicit GameRecordReader(const std::string &path):
+	data(nullptr),
+	size(0),
+	with_observations(false),
+	topology(CorrespondingBoardTopology::empty()),
+	factions_starting_point({0}),
+	game_offsets(nullptr),
+	nb_games(0)
+	{
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if(fd < 0)
+		{
+			throw std::runtime_error("[GameRecordReader]\tCould not open " + path);
+		}
+
+		struct stat file_stat;
+		if(::fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+		{
+			::close(fd);
+			throw std::runtime_error("[GameRecordReader]\tCould not stat " + path);
+		}
+		this->size = file_stat.st_size;
+
+		void *mapping = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if(mapping == MAP_FAILED)
+		{
+			throw std::runtime_error("[GameRecordReader]\tCould not map " + path);
+		}
+		this->data = static_cast<const uint8_t*>(mapping);
+
+		// the destructor does not run when the constructor throws
+		try
+		{
+			this->read_header();
+			this->read_footer();
+		}
+		catch(...)
+		{
+			::munmap(mapping, this->size);
+			throw;
+		}
+	}
+
+	GameRecordReader(const GameRecordReader&) = delete;
+	GameRecordReader& operator=(const GameRecordReader&) = delete;
+
+	~GameRecordReader()
+	{
+		if(this->data != nullptr)
+		{
+			::munmap(const_cast<uint8_t*>(this->data), this->size);
+		}
+	}
+
+	inline uint64_t get_nb_games(void) const
+	{
+		return this->nb_games;
+	}
+
+	inline bool has_observations(void) const
+	{
+		return this->with_observations;
+	}
+
+	inline const CorrespondingBoardTopology &get_topology(void) const
+	{
+		return this->topology;
+	}
+
+	inline const std::array<uint8_t, NB_FACTIONS> &get_factions_starting_point(void) const
+	{
+		return this->factions_starting_point;
+	}
+
+	inline uint64_t get_seed(const uint64_t game_idx) const
+	{
+		return this->read_value<uint64_t>(this->get_game_offset(game_idx));
+	}
+
+	inline uint32_t get_nb_steps(const uint64_t game_idx) const
+	{
+		return this->read_value<uint32_t>(this->get_game_offset(game_idx) + 8);
+	}
+
+	// OBS_SIZE bytes per step, nullptr if the file has no observations
+	const uint8_t *get_observations(const uint64_t game_idx) const
+	{
+		if(!this->with_observations)
+		{
+			return nullptr;
+		}
+
+		const size_t game_offset = this->get_game_offset(game_idx);
+		const size_t observations_offset = (
+			game_offset
+			+ CorrespondingFormat::GAME_HEADER_SIZE
+			+ this->read_value<uint32_t>(game_offset + 12)
+		);
+		if(
+			observations_offset > this->size
+			|| (size_t)this->get_nb_steps(game_idx) * CorrespondingFormat::OBS_SIZE > this->size - observations_offset
+		)
+		{
+			throw std::runtime_error("[GameRecordReader.get_observations]\tObservations do not fit in the file");
+		}
+		return this->data + observations_offset;
+	}
+
+	// decodes every step of game_idx, with the hand which played it
+	std::vector<Step> get_steps(const uint64_t game_idx) const
+	{
+		const size_t game_offset = this->get_game_offset(game_idx);
+		const uint32_t nb_steps = this->read_value<uint32_t>(game_offset + 8);
+		const uint32_t nb_token_bytes = this->read_value<uint32_t>(game_offset + 12);
+		if(nb_token_bytes > this->size - game_offset - CorrespondingFormat::GAME_HEADER_SIZE)
+		{
+			throw std::runtime_error("[GameRecordReader.get_steps]\tSteps do not fit in the file");
+		}
+		const uint8_t *tokens = this->data + game_offset + CorrespondingFormat::GAME_HEADER_SIZE;
+		const uint8_t *tokens_end = tokens + nb_token_bytes;
+
+		std::vector<Step> out;
+		out.reserve(nb_steps);
+		uint8_t hand_idx = 0;
+		for (uint32_t step_i = 0; step_i < nb_steps; ++step_i)
+		{
+			uint64_t token;
+			tokens = read_varint(tokens, tokens_end, token);
+			if(tokens == nullptr || token >= (uint64_t)CorrespondingMoveCodec::NB_MOVES + NB_FACTIONS)
+			{
+				throw std::runtime_error("[GameRecordReader.get_steps]\tCorrupted steps");
+			}
+
+			out.push_back(Step{
+				hand_idx,
+				CorrespondingFormat::to_move(token),
+				CorrespondingFormat::to_discarded_faction(token)
+			});
+
+			if(!CorrespondingFormat::is_failed_negociation(token))
+			{
+				++hand_idx;
+				hand_idx *= (hand_idx < NB_HANDS);
+			}
+		}
+		return out;
+	}
+
+	/*
+	 * the state of game_idx once its first nb_steps steps are played, nb_steps past the end gives the final state
+	 * make_move trusts its caller, so every step is checked first: a corrupted file could hold any move or discard
+	 */
+	CorrespondingGameStateType replay(const uint64_t game_idx, const uint32_t nb_steps = UINT32_MAX) const
+	{
+		auto out = CorrespondingGameStateType(this->topology, &this->factions_starting_point, this->get_seed(game_idx));
+
+		const auto steps = this->get_steps(game_idx);
+		for (uint32_t step_i = 0; step_i < nb_steps && step_i < steps.size(); ++step_i)
+		{
+			const Step &step = steps[step_i];
+			if(out.get_successive_negociation_counter() == NB_HANDS)
+			{
+				throw std::runtime_error("[GameRecordReader.replay]\tStep after the end of the game");
+			}
+			if(!out.is_legal(step.hand_idx, step.move))
+			{
+				throw std::runtime_error("[GameRecordReader.replay]\tIllegal move");
+			}
+
+			out.make_move(
+				step.hand_idx,
+				step.move,
+				[&step](const std::array<uint8_t, NB_FACTIONS> &hand){
+					// NB_FACTIONS is a recorded failed negociation
+					if(step.discarded_faction_idx < NB_FACTIONS && hand[step.discarded_faction_idx] == 0)
+					{
+						throw std::runtime_error("[GameRecordReader.replay]\tDiscarded faction is not in hand");
+					}
+					return step.discarded_faction_idx;
+				}
+			);
+		}
+		return out;
+	}
+};
+
+} // Turncoat
+#endif // GAMERECORD_HXX
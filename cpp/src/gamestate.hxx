@@ -2,13 +2,34 @@
 #ifndef GAMESTATE_HXX
 #define GAMESTATE_HXX
 
+#include <algorithm>
 #include <array>
+#include <numeric>
 #include <unordered_set>
 #include <functional>
 #include <random>
 #include <ctime>
 
 #include <iostream>
+#include <type_traits>
+
+#include "./move.hxx"
+#include "./random.hxx"
+#include "./stats.hxx"
+#include "./topology.hxx"
+#include "./util.hxx"
+#include "./zobrist.hxx"
+
+// define TURNCOAT_DEBUG_HASH to check the incremental hash against a full recompute after every change
+#ifdef TURNCOAT_DEBUG_HASH
+#define TURNCOAT_CHECK_HASH(GAME_STATE)															\
+	if((GAME_STATE).hash != (GAME_STATE).compute_hash())										\
+	{																							\
+		panic("[GameState]\tIncremental hash does not match full recompute");					\
+	}
+#else
+#define TURNCOAT_CHECK_HASH(GAME_STATE)
+#endif // TURNCOAT_DEBUG_HASH
 
 namespace Turncoat
 {
@@ -22,9 +43,62 @@ template<
 >
 class GameState
 {
+public:
+	using CorrespondingMoveCodec = MoveCodec<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION>;
+	using CorrespondingOrderType = Order<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION>;
+	using CorrespondingZobristKeys = ZobristKeys<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS>;
+	using CorrespondingBoardTopology = BoardTopology<NB_HEXAGONS>;
+
+	static constexpr MoveId NB_MOVES = CorrespondingMoveCodec::NB_MOVES;
+
+	/*
+	 * upper bound on the number of simultaneously legal moves, relying on each faction having at most NB_PER_FACTION units on the board:
+	 * one negociation, a deploy per (faction, hexagon),
+	 * at most min(units of both factions) + 1 attacks per (hexagon, atking faction, atked faction),
+	 * at most units + 1 rallies per (faction, start hexagon, neighbor)
+	 */
+	static constexpr MoveId MAX_LEGAL_MOVES = std::min<uint64_t>(
+		NB_MOVES,
+		1
+		+ (uint64_t)NB_FACTIONS * NB_HEXAGONS
+		+ (uint64_t)NB_FACTIONS * (NB_FACTIONS - 1) * (NB_HEXAGONS + NB_PER_FACTION)
+		+ (uint64_t)NB_FACTIONS * (NB_HEXAGONS - 1) * (NB_HEXAGONS + NB_PER_FACTION)
+	);
+
+	using MoveBuffer = std::array<MoveId, MAX_LEGAL_MOVES>;
+
+	// everything that changes during a game, cheap to copy around for tree search
+	struct Snapshot
+	{
+		std::array<std::array<uint8_t, NB_FACTIONS>, NB_HANDS> hands;
+		std::array<std::array<uint8_t, NB_FACTIONS>, NB_HEXAGONS> hexagons;
+		std::array<uint8_t, NB_FACTIONS> bag;
+		std::array<uint8_t, NB_FACTIONS> attack_zone;
+		std::array<uint8_t, NB_FACTIONS> rally_zone;
+		uint8_t successive_negociation_counter;
+		uint8_t winning_hand_idx;
+		uint64_t hash;
+		SplitMix64 random_generator;
+	};
+	static_assert(std::is_trivially_copyable_v<Snapshot>);
+
+	// what make_move needs to remember so that unmake_move can revert it
+	struct UndoRecord
+	{
+		SplitMix64 random_generator;
+		uint64_t hash;
+		MoveId move;
+		uint8_t hand_idx;
+		uint8_t successive_negociation_counter;
+		uint8_t winning_hand_idx;
+		uint8_t drawn_faction_idx; // negociate
+		uint8_t discarded_faction_idx; // negociate, NB_FACTIONS if the picker failed
+	};
+	static_assert(std::is_trivially_copyable_v<UndoRecord>);
+
 private:
 protected:
-	std::mt19937 *random_generator;
+	SplitMix64 random_generator;
 
 	uint8_t successive_negociation_counter;
 
@@ -34,11 +108,57 @@ protected:
 	std::array<std::array<uint8_t, NB_FACTIONS>, NB_HANDS> hands;
 	std::array<std::array<uint8_t, NB_FACTIONS>, NB_HEXAGONS> hexagons;
 
-	const std::array<std::array<bool, NB_HEXAGONS>, NB_HEXAGONS> *adjacency_graph; // maybe make this a simple array instead of pointer to array
-	const std::unordered_set<uint8_t> *unreachable_hexagons;
+	// held by value, a few bytes of bitmasks are cheaper to copy along than to chase through pointers
+	CorrespondingBoardTopology topology;
 
 	uint8_t winning_hand_idx;
 
+	// zobrist hash of hexagons, hands, bag, zones and negociation counter, kept up to date by every change below
+	uint64_t hash;
+
+	// every change of a hashed count goes through the following so that hash stays up to date
+
+	inline void add_to_count(uint8_t &count, const uint64_t *count_keys, const int16_t delta)
+	{
+		const uint8_t new_count = count + delta;
+		this->hash ^= count_keys[count] ^ count_keys[new_count];
+		count = new_count;
+	}
+
+	inline void add_to_hexagon(const uint8_t hexagon_idx, const uint8_t faction_idx, const int16_t delta)
+	{
+		this->add_to_count(this->hexagons[hexagon_idx][faction_idx], CorrespondingZobristKeys::hexagon(hexagon_idx, faction_idx), delta);
+	}
+
+	inline void add_to_hand(const uint8_t hand_idx, const uint8_t faction_idx, const int16_t delta)
+	{
+		this->add_to_count(this->hands[hand_idx][faction_idx], CorrespondingZobristKeys::hand(hand_idx, faction_idx), delta);
+	}
+
+	inline void add_to_bag(const uint8_t faction_idx, const int16_t delta)
+	{
+		this->add_to_count(this->bag[faction_idx], CorrespondingZobristKeys::bag(faction_idx), delta);
+	}
+
+	inline void add_to_attack_zone(const uint8_t faction_idx, const int16_t delta)
+	{
+		this->add_to_count(this->attack_zone[faction_idx], CorrespondingZobristKeys::attack_zone(faction_idx), delta);
+	}
+
+	inline void add_to_rally_zone(const uint8_t faction_idx, const int16_t delta)
+	{
+		this->add_to_count(this->rally_zone[faction_idx], CorrespondingZobristKeys::rally_zone(faction_idx), delta);
+	}
+
+	inline void set_successive_negociation_counter(const uint8_t successive_negociation_counter)
+	{
+		this->hash ^= (
+			CorrespondingZobristKeys::negociation_counter(this->successive_negociation_counter)
+			^ CorrespondingZobristKeys::negociation_counter(successive_negociation_counter)
+		);
+		this->successive_negociation_counter = successive_negociation_counter;
+	}
+
 	inline uint8_t total_in_bag(void) const
 	{
 		return std::accumulate(this->bag.begin() , this->bag.end(), 0);
@@ -46,12 +166,9 @@ protected:
 
 	uint8_t draw_random_from_bag(void)
 	{
-		const auto alpha = this->random_generator->min();
-		const auto beta = this->random_generator->max();
-		const auto x = (*(this->random_generator))(); // random variable
-		const auto chosen_unit = this->total_in_bag() * (x - alpha) / (beta - alpha);
+		const auto chosen_unit = this->random_generator.uniform(this->total_in_bag());
 
-		auto accumulated_units = 0;
+		uint32_t accumulated_units = 0;
 		uint8_t faction_i = 0;
 		
 		for (; faction_i < NB_FACTIONS; ++faction_i)
@@ -64,24 +181,131 @@ protected:
 			}
 		}
 
-		--(this->bag[faction_i]);
+		this->add_to_bag(faction_i, -1);
 		return faction_i;
 	}
 
 	inline bool is_hexagon_reachable(const uint8_t hexagon_idx) const
 	{
-		return (
-			std::find(
-				this->unreachable_hexagons->begin(),
-				this->unreachable_hexagons->end(),
-				hexagon_idx
-			) == this->unreachable_hexagons->end()
-		);
+		return this->topology.is_reachable(hexagon_idx);
 	}
 
 	inline bool are_hexagons_adjacent(const uint8_t first_hexagon_idx, const uint8_t second_hexagon_idx) const
 	{
-		return (*(this->adjacency_graph))[first_hexagon_idx][second_hexagon_idx];
+		return this->topology.are_adjacent(first_hexagon_idx, second_hexagon_idx);
+	}
+
+	inline bool can_negociate(void) const
+	{
+		return this->total_in_bag() > 0;
+	}
+
+	inline bool can_attack(
+		const uint8_t hand_idx,
+		const uint8_t atking_faction_idx,
+		const uint8_t atked_faction_idx,
+		const uint8_t nb_atked_units,
+		const uint8_t hexagon_idx
+	) const
+	{
+		return !(
+			this->hands[hand_idx][atking_faction_idx] == 0
+			|| !this->is_hexagon_reachable(hexagon_idx)
+			|| atking_faction_idx == atked_faction_idx
+			|| this->hexagons[hexagon_idx][atking_faction_idx] < nb_atked_units
+			|| this->hexagons[hexagon_idx][atked_faction_idx] < nb_atked_units
+		);
+	}
+
+	inline bool can_rally(
+		const uint8_t hand_idx,
+		const uint8_t faction_idx,
+		const uint8_t nb_units,
+		const uint8_t start_hexagon_idx,
+		const uint8_t end_hexagon_idx
+	) const
+	{
+		return !(
+			this->hands[hand_idx][faction_idx] == 0
+			|| !this->is_hexagon_reachable(start_hexagon_idx)
+			|| !this->is_hexagon_reachable(end_hexagon_idx)
+			|| this->hexagons[start_hexagon_idx][faction_idx] < nb_units
+			|| !this->are_hexagons_adjacent(start_hexagon_idx, end_hexagon_idx)
+		);
+	}
+
+	// any hexagon will do, only the hand matters
+	inline bool can_deploy(
+		const uint8_t hand_idx,
+		const uint8_t faction_idx
+	) const
+	{
+		return this->hands[hand_idx][faction_idx] >= 1;
+	}
+
+	/*
+	 * for TURNCOAT_STATS, called by the checked orders only (attack, rally, deploy, negociate, apply) once they succeeded,
+	 * so that what make_move plays for search or replays is not counted
+	 */
+	static inline void count_order_stats(const bool is_negociation, const uint8_t previous_successive_negociation_counter)
+	{
+		TURNCOAT_COUNT(TURNS);
+		if(!is_negociation && previous_successive_negociation_counter > 0)
+		{
+			TURNCOAT_COUNT_NEGOCIATION_STREAK(previous_successive_negociation_counter);
+		}
+		if(is_negociation && previous_successive_negociation_counter + 1 == NB_HANDS)
+		{
+			TURNCOAT_COUNT_NEGOCIATION_STREAK(NB_HANDS);
+		}
+	}
+
+	// the apply_* methods below assume the matching can_* check passed
+
+	inline void apply_attack(
+		const uint8_t hand_idx,
+		const uint8_t atking_faction_idx,
+		const uint8_t atked_faction_idx,
+		const uint8_t nb_atked_units,
+		const uint8_t hexagon_idx
+	)
+	{
+		this->add_to_hand(hand_idx, atking_faction_idx, -1);
+		this->add_to_attack_zone(atking_faction_idx, +1);
+
+		this->add_to_hexagon(hexagon_idx, atked_faction_idx, -nb_atked_units);
+		this->add_to_bag(atked_faction_idx, +nb_atked_units);
+
+		this->set_successive_negociation_counter(0);
+	}
+
+	inline void apply_rally(
+		const uint8_t hand_idx,
+		const uint8_t faction_idx,
+		const uint8_t nb_units,
+		const uint8_t start_hexagon_idx,
+		const uint8_t end_hexagon_idx
+	)
+	{
+		this->add_to_hexagon(start_hexagon_idx, faction_idx, -nb_units);
+		this->add_to_hexagon(end_hexagon_idx, faction_idx, +nb_units);
+
+		this->add_to_hand(hand_idx, faction_idx, -1);
+		this->add_to_rally_zone(faction_idx, +1);
+
+		this->set_successive_negociation_counter(0);
+	}
+
+	inline void apply_deploy(
+		const uint8_t hand_idx,
+		const uint8_t faction_idx,
+		const uint8_t hexagon_idx
+	)
+	{
+		this->add_to_hand(hand_idx, faction_idx, -1);
+		this->add_to_hexagon(hexagon_idx, faction_idx, +1);
+
+		this->set_successive_negociation_counter(0);
 	}
 
 	// returns arr.size() if tied
@@ -160,22 +384,46 @@ protected:
 
 
 public:
+	// the shared generator is only used to seed this state's own one, every later draw is local
 	GameState(
 		const std::array<std::array<bool, NB_HEXAGONS>, NB_HEXAGONS> *adjacency_graph,
 		const std::array<uint8_t, NB_FACTIONS> *factions_starting_point,
 		const std::unordered_set<uint8_t> *unreachable_hexagons,
 		std::mt19937 *random_generator
 	):
-	hands({0}),
-	hexagons({0}),
+	GameState(adjacency_graph, factions_starting_point, unreachable_hexagons, seed_from(random_generator))
+	{}
+
+	// for maps only known at runtime, the graph and the set are converted once here and not referenced afterwards
+	GameState(
+		const std::array<std::array<bool, NB_HEXAGONS>, NB_HEXAGONS> *adjacency_graph,
+		const std::array<uint8_t, NB_FACTIONS> *factions_starting_point,
+		const std::unordered_set<uint8_t> *unreachable_hexagons,
+		const uint64_t seed
+	):
+	GameState(
+		CorrespondingBoardTopology::from_adjacency_graph(*adjacency_graph, *unreachable_hexagons),
+		factions_starting_point,
+		seed
+	)
+	{}
+
+	// the whole game, including its initial draws, is determined by seed
+	GameState(
+		const CorrespondingBoardTopology &topology,
+		const std::array<uint8_t, NB_FACTIONS> *factions_starting_point,
+		const uint64_t seed
+	):
+	random_generator{seed},
+	successive_negociation_counter(0),
 	attack_zone({0}),
 	rally_zone({0}),
 	bag({0}),
-	successive_negociation_counter(0),
-	adjacency_graph(adjacency_graph),
-	unreachable_hexagons(unreachable_hexagons),
-	random_generator(random_generator),
-	winning_hand_idx(NB_HANDS)
+	hands({0}),
+	hexagons({0}),
+	topology(topology),
+	winning_hand_idx(NB_HANDS),
+	hash(0)
 	{
 		for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
 		{
@@ -219,6 +467,48 @@ public:
 				++(this->hands[hand_i][drawn_faction]);
 			}
 		}
+
+		this->hash = this->compute_hash();
+	}
+
+	// what the std::mt19937 constructor seeds the state with
+	static uint64_t seed_from(std::mt19937 *random_generator)
+	{
+		const uint64_t high = (*random_generator)();
+		const uint64_t low = (*random_generator)();
+		return (high << 32) | low;
+	}
+
+	uint64_t get_hash(void) const
+	{
+		return this->hash;
+	}
+
+	// for code which wrote the fields directly (such as tests), instead of through the changes above
+	void recompute_hash(void)
+	{
+		this->hash = this->compute_hash();
+	}
+
+	// full recompute, the incremental one is what get_hash returns
+	uint64_t compute_hash(void) const
+	{
+		uint64_t out = CorrespondingZobristKeys::negociation_counter(this->successive_negociation_counter);
+		for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
+		{
+			for (uint8_t hexagon_i = 0; hexagon_i < NB_HEXAGONS; ++hexagon_i)
+			{
+				out ^= CorrespondingZobristKeys::hexagon(hexagon_i, faction_i)[this->hexagons[hexagon_i][faction_i]];
+			}
+			for (uint8_t hand_i = 0; hand_i < NB_HANDS; ++hand_i)
+			{
+				out ^= CorrespondingZobristKeys::hand(hand_i, faction_i)[this->hands[hand_i][faction_i]];
+			}
+			out ^= CorrespondingZobristKeys::bag(faction_i)[this->bag[faction_i]];
+			out ^= CorrespondingZobristKeys::attack_zone(faction_i)[this->attack_zone[faction_i]];
+			out ^= CorrespondingZobristKeys::rally_zone(faction_i)[this->rally_zone[faction_i]];
+		}
+		return out;
 	}
 
 	uint8_t get_successive_negociation_counter(void) const
@@ -226,27 +516,61 @@ public:
 		return this->successive_negociation_counter;
 	}
 
-	// returns whether it succeeded
-	bool negociate(
-		const uint8_t hand_idx,
-		const std::function<uint8_t(const std::array<uint8_t, NB_FACTIONS>&)> discarded_faction_picker
-	)
+	const CorrespondingBoardTopology &get_topology(void) const
 	{
-		++successive_negociation_counter;
-		
-		const auto drawn_idx = this->draw_random_from_bag();
-		++(this->hands[hand_idx][drawn_idx]);
+		return this->topology;
+	}
+
+	const std::array<std::array<uint8_t, NB_FACTIONS>, NB_HANDS> &get_hands(void) const
+	{
+		return this->hands;
+	}
 
-		const auto chosen_faction = discarded_faction_picker(this->hands[hand_idx]);
-		if(this->hands[hand_idx][chosen_faction] == 0)
+	const std::array<std::array<uint8_t, NB_FACTIONS>, NB_HEXAGONS> &get_hexagons(void) const
+	{
+		return this->hexagons;
+	}
+
+	const std::array<uint8_t, NB_FACTIONS> &get_bag(void) const
+	{
+		return this->bag;
+	}
+
+	const std::array<uint8_t, NB_FACTIONS> &get_attack_zone(void) const
+	{
+		return this->attack_zone;
+	}
+
+	const std::array<uint8_t, NB_FACTIONS> &get_rally_zone(void) const
+	{
+		return this->rally_zone;
+	}
+
+	// returns whether it succeeded
+	// the picker is a template parameter so that native policies get it inlined, std::function works as well
+	template<typename DiscardedFactionPicker>
+	bool negociate(const uint8_t hand_idx, DiscardedFactionPicker &&discarded_faction_picker)
+	{
+		if(!this->can_negociate())
 		{
-			++(this->bag[drawn_idx]); // putting back in place
+			TURNCOAT_COUNT(FAILED_NEGOCIATIONS);
 			return false;
 		}
 
-		--(this->hands[hand_idx][chosen_faction]);
-		++(this->bag[chosen_faction]);
+		// drawn even if the discard fails
+		TURNCOAT_COUNT(BAG_DRAWS);
+		const auto undo_record = this->make_move(
+			hand_idx,
+			CorrespondingMoveCodec::encode_negociate(),
+			discarded_faction_picker
+		);
+		if(undo_record.discarded_faction_idx == NB_FACTIONS)
+		{
+			TURNCOAT_COUNT(FAILED_NEGOCIATIONS);
+			return false;
+		}
 
+		count_order_stats(true, undo_record.successive_negociation_counter);
 		return true;
 	}
 
@@ -259,24 +583,15 @@ public:
 		const uint8_t hexagon_idx
 	)
 	{
-		if(
-			this->hands[hand_idx][atking_faction_idx] == 0
-			|| !this->is_hexagon_reachable(hexagon_idx)
-			|| atking_faction_idx == atked_faction_idx
-			|| this->hexagons[hexagon_idx][atking_faction_idx] < nb_atked_units
-			|| this->hexagons[hexagon_idx][atked_faction_idx] < nb_atked_units
-		)
+		if(!this->can_attack(hand_idx, atking_faction_idx, atked_faction_idx, nb_atked_units, hexagon_idx))
 		{
+			TURNCOAT_COUNT(FAILED_ATTACKS);
 			return false;
 		}
 
-		--(this->hands[hand_idx][atking_faction_idx]);
-		++(this->attack_zone[atking_faction_idx]);
-
-		this->hexagons[hexagon_idx][atked_faction_idx] -= nb_atked_units;
-		this->bag[atked_faction_idx] += nb_atked_units;
-
-		this->successive_negociation_counter = 0;
+		count_order_stats(false, this->successive_negociation_counter);
+		this->apply_attack(hand_idx, atking_faction_idx, atked_faction_idx, nb_atked_units, hexagon_idx);
+		TURNCOAT_CHECK_HASH(*this)
 
 		return true;
 	}
@@ -290,24 +605,15 @@ public:
 		const uint8_t end_hexagon_idx
 	)
 	{
-		if(
-			this->hands[hand_idx][faction_idx] == 0
-			|| !this->is_hexagon_reachable(start_hexagon_idx)
-			|| !this->is_hexagon_reachable(end_hexagon_idx)
-			|| this->hexagons[start_hexagon_idx][faction_idx] < nb_units
-			|| !this->are_hexagons_adjacent(start_hexagon_idx, end_hexagon_idx)
-		)
+		if(!this->can_rally(hand_idx, faction_idx, nb_units, start_hexagon_idx, end_hexagon_idx))
 		{
+			TURNCOAT_COUNT(FAILED_RALLIES);
 			return false;
 		}
 
-		this->hexagons[start_hexagon_idx][faction_idx] -= nb_units;
-		this->hexagons[end_hexagon_idx][faction_idx] += nb_units;
-
-		--(this->hands[hand_idx][faction_idx]);
-		++(this->rally_zone[faction_idx]);
-
-		this->successive_negociation_counter = 0;
+		count_order_stats(false, this->successive_negociation_counter);
+		this->apply_rally(hand_idx, faction_idx, nb_units, start_hexagon_idx, end_hexagon_idx);
+		TURNCOAT_CHECK_HASH(*this)
 
 		return true;
 	}
@@ -318,19 +624,355 @@ public:
 		const uint8_t faction_idx,
 		const uint8_t hexagon_idx
 	){
-		if (this->hands[hand_idx][faction_idx] < 1)
+		if (!this->can_deploy(hand_idx, faction_idx))
+		{
+			TURNCOAT_COUNT(FAILED_DEPLOYS);
+			return false;
+		}
+
+		count_order_stats(false, this->successive_negociation_counter);
+		this->apply_deploy(hand_idx, faction_idx, hexagon_idx);
+		TURNCOAT_CHECK_HASH(*this)
+
+		return true;
+	}
+
+	/*
+	 * writes every legal move of the given hand in moves, returns how many were written
+	 * goes through the same can_* checks as attack, rally, deploy and negociate, without allocating
+	 */
+	MoveId generate_legal_moves(const uint8_t hand_idx, MoveBuffer &moves) const
+	{
+		MoveId nb_moves = 0;
+
+		if(this->can_negociate())
+		{
+			moves[nb_moves++] = CorrespondingMoveCodec::encode_negociate();
+		}
+
+		for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
+		{
+			// attacks and rallies need a unit of the faction in hand as well
+			if(!this->can_deploy(hand_idx, faction_i))
+			{
+				continue;
+			}
+
+			for (uint8_t hexagon_i = 0; hexagon_i < NB_HEXAGONS; ++hexagon_i)
+			{
+				moves[nb_moves++] = CorrespondingMoveCodec::encode_deploy(faction_i, hexagon_i);
+			}
+
+			for (uint8_t hexagon_i = 0; hexagon_i < NB_HEXAGONS; ++hexagon_i)
+			{
+				if(!this->is_hexagon_reachable(hexagon_i))
+				{
+					continue;
+				}
+
+				const uint8_t nb_atking_units = this->hexagons[hexagon_i][faction_i];
+
+				// attacks
+				for (uint8_t atked_faction_i = 0; atked_faction_i < NB_FACTIONS; ++atked_faction_i)
+				{
+					if(atked_faction_i == faction_i)
+					{
+						continue;
+					}
+
+					const uint8_t max_atked_units = std::min<uint8_t>(
+						std::min(nb_atking_units, this->hexagons[hexagon_i][atked_faction_i]),
+						NB_PER_FACTION - 1
+					);
+					for (uint16_t nb_units = 0; nb_units <= max_atked_units; ++nb_units)
+					{
+						moves[nb_moves++] = CorrespondingMoveCodec::encode_attack(faction_i, atked_faction_i, nb_units, hexagon_i);
+					}
+				}
+
+				// rallies starting from here, walking the set bits in increasing order
+				const uint8_t max_rallied_units = std::min<uint8_t>(nb_atking_units, NB_PER_FACTION - 1);
+				for (
+					auto end_hexagons = this->topology.get_reachable_neighbors(hexagon_i);
+					end_hexagons != 0;
+					end_hexagons &= end_hexagons - 1
+				)
+				{
+					const uint8_t end_hexagon_i = lowest_hexagon_idx(end_hexagons);
+					for (uint16_t nb_units = 0; nb_units <= max_rallied_units; ++nb_units)
+					{
+						moves[nb_moves++] = CorrespondingMoveCodec::encode_rally(faction_i, nb_units, hexagon_i, end_hexagon_i);
+					}
+				}
+			}
+		}
+
+		return nb_moves;
+	}
+
+	// whether generate_legal_moves(hand_idx, ...) would write move, without generating every legal move
+	bool is_legal(const uint8_t hand_idx, const MoveId move) const
+	{
+		if(move >= NB_MOVES)
+		{
+			return false;
+		}
+
+		const auto order = CorrespondingMoveCodec::decode(move);
+		switch(order.order_type)
+		{
+			case ATTACK:
+				return this->can_attack(
+					hand_idx,
+					order.atking_faction_idx,
+					order.atked_faction_idx,
+					order.nb_atked_units,
+					order.hexagon_idx
+				);
+
+			case DEPLOY:
+				return this->can_deploy(hand_idx, order.faction_idx);
+
+			case RALLY:
+				return this->can_rally(
+					hand_idx,
+					order.faction_idx,
+					order.nb_units,
+					order.start_hexagon_idx,
+					order.end_hexagon_idx
+				);
+
+			case NEGOCIATE:
+			default:
+				return this->can_negociate();
+		}
+	}
+
+	/*
+	 * fast path for moves coming from generate_legal_moves: attack, rally and deploy are not re-validated
+	 * returns whether it succeeded, which can only fail for a negociation whose picker returns a faction absent from hand
+	 */
+	template<typename DiscardedFactionPicker>
+	bool apply(const uint8_t hand_idx, const MoveId move, DiscardedFactionPicker &&discarded_faction_picker)
+	{
+		const auto order = CorrespondingMoveCodec::decode(move);
+		switch(order.order_type)
+		{
+			case ATTACK:
+				count_order_stats(false, this->successive_negociation_counter);
+				this->apply_attack(
+					hand_idx,
+					order.atking_faction_idx,
+					order.atked_faction_idx,
+					order.nb_atked_units,
+					order.hexagon_idx
+				);
+				TURNCOAT_CHECK_HASH(*this)
+				return true;
+
+			case DEPLOY:
+				count_order_stats(false, this->successive_negociation_counter);
+				this->apply_deploy(hand_idx, order.faction_idx, order.hexagon_idx);
+				TURNCOAT_CHECK_HASH(*this)
+				return true;
+
+			case RALLY:
+				count_order_stats(false, this->successive_negociation_counter);
+				this->apply_rally(
+					hand_idx,
+					order.faction_idx,
+					order.nb_units,
+					order.start_hexagon_idx,
+					order.end_hexagon_idx
+				);
+				TURNCOAT_CHECK_HASH(*this)
+				return true;
+
+			case NEGOCIATE:
+			default:
+				return this->negociate(hand_idx, discarded_faction_picker);
+		}
+	}
+
+	/*
+	 * negociation split in its two halves, for callers which only learn the discarded faction later on (e.g. VecGameEnv)
+	 * draw_for_negociation assumes can_negociate(), discard_for_negociation returns whether the discarded faction was in hand
+	 */
+	uint8_t draw_for_negociation(const uint8_t hand_idx)
+	{
+		const uint8_t drawn_idx = this->draw_random_from_bag();
+		this->add_to_hand(hand_idx, drawn_idx, +1);
+		return drawn_idx;
+	}
+
+	bool discard_for_negociation(const uint8_t hand_idx, const uint8_t discarded_faction_idx)
+	{
+		if(discarded_faction_idx >= NB_FACTIONS || this->hands[hand_idx][discarded_faction_idx] == 0)
 		{
 			return false;
 		}
 
-		--(this->hands[hand_idx][faction_idx]);
-		++(this->hexagons[hexagon_idx][faction_idx]);
+		this->add_to_hand(hand_idx, discarded_faction_idx, -1);
+		this->add_to_bag(discarded_faction_idx, +1);
 
-		this->successive_negociation_counter = 0;
+		this->set_successive_negociation_counter(this->successive_negociation_counter + 1);
 
 		return true;
 	}
 
+	Snapshot snapshot(void) const
+	{
+		return Snapshot{
+			this->hands,
+			this->hexagons,
+			this->bag,
+			this->attack_zone,
+			this->rally_zone,
+			this->successive_negociation_counter,
+			this->winning_hand_idx,
+			this->hash,
+			this->random_generator
+		};
+	}
+
+	void restore(const Snapshot &snapshot)
+	{
+		this->hands = snapshot.hands;
+		this->hexagons = snapshot.hexagons;
+		this->bag = snapshot.bag;
+		this->attack_zone = snapshot.attack_zone;
+		this->rally_zone = snapshot.rally_zone;
+		this->successive_negociation_counter = snapshot.successive_negociation_counter;
+		this->winning_hand_idx = snapshot.winning_hand_idx;
+		this->hash = snapshot.hash;
+		this->random_generator = snapshot.random_generator;
+	}
+
+	/*
+	 * same as apply, but returns what unmake_move needs to revert the move
+	 * the picker is a template parameter so that search code can have it inlined
+	 * a failed negociation leaves the state untouched apart from the generator, and is recorded as such
+	 * so is a negociation with an empty bag, which does not even touch the generator
+	 */
+	template<typename DiscardedFactionPicker>
+	UndoRecord make_move(const uint8_t hand_idx, const MoveId move, DiscardedFactionPicker &&discarded_faction_picker)
+	{
+		UndoRecord undo_record{
+			this->random_generator,
+			this->hash,
+			move,
+			hand_idx,
+			this->successive_negociation_counter,
+			this->winning_hand_idx,
+			NB_FACTIONS,
+			NB_FACTIONS
+		};
+
+		const auto order = CorrespondingMoveCodec::decode(move);
+		switch(order.order_type)
+		{
+			case ATTACK:
+				this->apply_attack(
+					hand_idx,
+					order.atking_faction_idx,
+					order.atked_faction_idx,
+					order.nb_atked_units,
+					order.hexagon_idx
+				);
+				break;
+
+			case DEPLOY:
+				this->apply_deploy(hand_idx, order.faction_idx, order.hexagon_idx);
+				break;
+
+			case RALLY:
+				this->apply_rally(
+					hand_idx,
+					order.faction_idx,
+					order.nb_units,
+					order.start_hexagon_idx,
+					order.end_hexagon_idx
+				);
+				break;
+
+			case NEGOCIATE:
+			default:
+			{
+				if(!this->can_negociate())
+				{
+					break;
+				}
+
+				const uint8_t drawn_idx = this->draw_for_negociation(hand_idx);
+				undo_record.drawn_faction_idx = drawn_idx;
+
+				const uint8_t chosen_faction = discarded_faction_picker(this->hands[hand_idx]);
+				if(!this->discard_for_negociation(hand_idx, chosen_faction))
+				{
+					// putting back in place
+					this->add_to_hand(hand_idx, drawn_idx, -1);
+					this->add_to_bag(drawn_idx, +1);
+					break;
+				}
+
+				undo_record.discarded_faction_idx = chosen_faction;
+				break;
+			}
+		}
+		TURNCOAT_CHECK_HASH(*this)
+
+		return undo_record;
+	}
+
+	void unmake_move(const UndoRecord &undo_record)
+	{
+		const auto hand_idx = undo_record.hand_idx;
+		const auto order = CorrespondingMoveCodec::decode(undo_record.move);
+		switch(order.order_type)
+		{
+			case ATTACK:
+				++(this->hands[hand_idx][order.atking_faction_idx]);
+				--(this->attack_zone[order.atking_faction_idx]);
+
+				this->hexagons[order.hexagon_idx][order.atked_faction_idx] += order.nb_atked_units;
+				this->bag[order.atked_faction_idx] -= order.nb_atked_units;
+				break;
+
+			case DEPLOY:
+				++(this->hands[hand_idx][order.faction_idx]);
+				--(this->hexagons[order.hexagon_idx][order.faction_idx]);
+				break;
+
+			case RALLY:
+				this->hexagons[order.start_hexagon_idx][order.faction_idx] += order.nb_units;
+				this->hexagons[order.end_hexagon_idx][order.faction_idx] -= order.nb_units;
+
+				++(this->hands[hand_idx][order.faction_idx]);
+				--(this->rally_zone[order.faction_idx]);
+				break;
+
+			case NEGOCIATE:
+			default:
+				if(undo_record.discarded_faction_idx == NB_FACTIONS)
+				{
+					break;
+				}
+
+				++(this->hands[hand_idx][undo_record.discarded_faction_idx]);
+				--(this->bag[undo_record.discarded_faction_idx]);
+
+				--(this->hands[hand_idx][undo_record.drawn_faction_idx]);
+				++(this->bag[undo_record.drawn_faction_idx]);
+				break;
+		}
+
+		this->successive_negociation_counter = undo_record.successive_negociation_counter;
+		this->winning_hand_idx = undo_record.winning_hand_idx;
+		this->hash = undo_record.hash;
+		this->random_generator = undo_record.random_generator;
+		TURNCOAT_CHECK_HASH(*this)
+	}
+
 	uint8_t get_winning_hand(void)
 	{
 		if(this->winning_hand_idx != NB_HANDS)
@@ -398,7 +1040,7 @@ public:
 		}
 
 		// in the end decide a random winning_hand_idx
-		const uint8_t random_winning_hand_idx = (*(this->random_generator))() % NB_HANDS; 
+		const uint8_t random_winning_hand_idx = this->random_generator.uniform(NB_HANDS);
 
 		this->winning_hand_idx = random_winning_hand_idx;
 
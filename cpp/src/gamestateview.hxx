@@ -0,0 +1,118 @@
+#pragma once
+#ifndef GAMESTATEVIEW_HXX
+#define GAMESTATEVIEW_HXX
+
+#include <array>
+#include <cstdint>
+
+#include "./gamestate.hxx"
+#include "./gameview.hxx"
+#include "./move.hxx"
+
+namespace Turncoat
+{
+
+/*
+ * what GameView shows, read in place from a GameState instead of copied:
+ * the board, the zones, the hand of hand_idx and the size of every hand, but not what is in the other hands nor in the bag
+ * only valid as long as the game state it was built from, which is meant to be for the duration of a policy call
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_HANDS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+class GameStateView
+{
+public:
+	using CorrespondingGameStateType = GameState<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingGameViewType = GameView<NB_HEXAGONS, NB_FACTIONS, NB_HANDS>;
+	using MoveBuffer = typename CorrespondingGameStateType::MoveBuffer;
+
+protected:
+	const CorrespondingGameStateType &game_state;
+	const uint8_t hand_idx;
+
+public:
+	GameStateView(const CorrespondingGameStateType &game_state, const uint8_t hand_idx):
+	game_state(game_state),
+	hand_idx(hand_idx)
+	{}
+
+	inline uint8_t get_hand_idx(void) const
+	{
+		return this->hand_idx;
+	}
+
+	inline const std::array<uint8_t, NB_FACTIONS> &get_hand(void) const
+	{
+		return this->game_state.get_hands()[this->hand_idx];
+	}
+
+	inline uint8_t get_hand_size(const uint8_t hand_idx) const
+	{
+		uint8_t out = 0;
+		for (const auto nb_units : this->game_state.get_hands()[hand_idx])
+		{
+			out += nb_units;
+		}
+		return out;
+	}
+
+	inline const std::array<std::array<uint8_t, NB_FACTIONS>, NB_HEXAGONS> &get_hexagons(void) const
+	{
+		return this->game_state.get_hexagons();
+	}
+
+	inline const std::array<uint8_t, NB_FACTIONS> &get_attack_zone(void) const
+	{
+		return this->game_state.get_attack_zone();
+	}
+
+	inline const std::array<uint8_t, NB_FACTIONS> &get_rally_zone(void) const
+	{
+		return this->game_state.get_rally_zone();
+	}
+
+	inline uint8_t get_successive_negociation_counter(void) const
+	{
+		return this->game_state.get_successive_negociation_counter();
+	}
+
+	inline const typename CorrespondingGameStateType::CorrespondingBoardTopology &get_topology(void) const
+	{
+		return this->game_state.get_topology();
+	}
+
+	// legality of hand_idx's moves only depends on their hand, the board and whether the bag is empty
+	inline MoveId generate_legal_moves(MoveBuffer &moves) const
+	{
+		return this->game_state.generate_legal_moves(this->hand_idx, moves);
+	}
+
+	// owning copy, for policies which outlive the call or go through std::function
+	CorrespondingGameViewType to_game_view(void) const
+	{
+		std::array<uint8_t, NB_HANDS> hand_sizes;
+		for (uint8_t hand_i = 0; hand_i < NB_HANDS; ++hand_i)
+		{
+			hand_sizes[hand_i] = this->get_hand_size(hand_i);
+		}
+
+		return CorrespondingGameViewType(
+			this->get_attack_zone(),
+			this->get_rally_zone(),
+			this->get_hand(),
+			this->get_hexagons(),
+			hand_sizes,
+			this->hand_idx,
+			this->get_successive_negociation_counter()
+		);
+	}
+};
+
+} // Turncoat
+#endif // GAMESTATEVIEW_HXX
@@ -5,9 +5,15 @@
 namespace Turncoat
 {
 
+/*
+ * what a player can see: the board, the zones, their own hand,
+ * and the size of every hand (each order but negociation costs one unit, so sizes are public)
+ * what is in the other hands and in the bag stays hidden
+ */
 template<
 	uint8_t NB_HEXAGONS,
-	uint8_t NB_FACTIONS
+	uint8_t NB_FACTIONS,
+	uint8_t NB_HANDS
 >
 struct GameView
 {
@@ -15,17 +21,26 @@ struct GameView
 	const std::array<uint8_t, NB_FACTIONS> rally_zone;
 	const std::array<uint8_t, NB_FACTIONS> hand;
 	const std::array<std::array<uint8_t, NB_FACTIONS>, NB_HEXAGONS> hexagons;
+	const std::array<uint8_t, NB_HANDS> hand_sizes;
+	const uint8_t hand_idx;
+	const uint8_t successive_negociation_counter;
 
 	GameView(
 		const std::array<uint8_t, NB_FACTIONS> attack_zone,
 		const std::array<uint8_t, NB_FACTIONS> rally_zone,
 		const std::array<uint8_t, NB_FACTIONS> hand,
-		const std::array<std::array<uint8_t, NB_FACTIONS>, NB_HEXAGONS> hexagons
+		const std::array<std::array<uint8_t, NB_FACTIONS>, NB_HEXAGONS> hexagons,
+		const std::array<uint8_t, NB_HANDS> hand_sizes,
+		const uint8_t hand_idx,
+		const uint8_t successive_negociation_counter
 	):
 	attack_zone(attack_zone),
 	rally_zone(rally_zone),
 	hand(hand),
-	hexagons(hexagons)
+	hexagons(hexagons),
+	hand_sizes(hand_sizes),
+	hand_idx(hand_idx),
+	successive_negociation_counter(successive_negociation_counter)
 	{}
 };
 
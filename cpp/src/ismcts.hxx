@@ -0,0 +1,513 @@
+#pragma once
+#ifndef ISMCTS_HXX
+#define ISMCTS_HXX
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "./gamestate.hxx"
+#include "./gamestateview.hxx"
+#include "./gameview.hxx"
+#include "./move.hxx"
+#include "./order.hxx"
+#include "./random.hxx"
+#include "./topology.hxx"
+#include "./util.hxx"
+
+namespace Turncoat
+{
+
+struct ISMCTSConfig
+{
+	uint32_t nb_iterations = 1000; // per move, shared among threads, 0 for no limit
+	uint32_t time_budget_ms = 0; // per move, 0 for no limit
+	uint32_t nb_threads = 1; // 0 uses every core
+	float exploration = 0.7f;
+	uint64_t seed = 0;
+};
+
+/*
+ * information set monte carlo tree search, from the point of view of the hand to play
+ *
+ * every iteration samples the hidden units (other hands and bag) consistently with the game view, then walks the tree
+ * using only the moves legal in that sample: a child is scored with its availability count (how many times it could have
+ * been picked) instead of its parent visits, so that rarely legal moves are not over-explored (ISUCT)
+ * rewards are 1 for the winning hand and 0 for the others, each node keeping those of the hand which played its move
+ *
+ * root-parallel: each thread grows its own tree in its own arena from its own samples, root visits are summed at the end
+ * so there is no shared node to lock nor any virtual loss to apply
+ * arenas are kept between searches and only cleared, so that a game does not allocate once they are big enough
+ *
+ * get_order plugs into GameHandler's order_getters, pick_discarded_faction into its discarded_faction_pickers,
+ * and both make it a StaticGameHandler policy
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_HANDS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+class ISMCTS
+{
+public:
+	using CorrespondingGameStateType = GameState<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingGameViewType = GameView<NB_HEXAGONS, NB_FACTIONS, NB_HANDS>;
+	using CorrespondingGameStateViewType = GameStateView<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingMoveCodec = typename CorrespondingGameStateType::CorrespondingMoveCodec;
+	using CorrespondingOrderType = typename CorrespondingGameStateType::CorrespondingOrderType;
+	using CorrespondingBoardTopology = typename CorrespondingGameStateType::CorrespondingBoardTopology;
+	using MoveBuffer = typename CorrespondingGameStateType::MoveBuffer;
+
+	static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+	struct Node
+	{
+		uint32_t first_child_idx;
+		uint32_t next_sibling_idx;
+		uint32_t nb_visits;
+		uint32_t nb_availabilities;
+		float total_reward; // of the hand which played move
+		MoveId move;
+		uint8_t hand_idx;
+	};
+
+protected:
+	// per thread, kept from one search to the next
+	struct Worker
+	{
+		std::vector<Node> arena;
+		std::vector<uint8_t> move_marks; // [NB_MOVES], 0 outside of select_or_expand
+		MoveBuffer moves;
+		std::vector<uint32_t> path;
+		uint32_t nb_iterations;
+	};
+
+	enum MoveMark : uint8_t
+	{
+		ILLEGAL = 0,
+		UNTRIED = 1,
+		TRIED = 2
+	};
+
+	const CorrespondingBoardTopology topology;
+	const std::array<uint8_t, NB_FACTIONS> factions_starting_point;
+	const ISMCTSConfig config;
+
+	std::vector<Worker> workers;
+	SplitMix64 random_generator; // seeds searches, and discards
+	uint64_t nb_searches;
+	std::vector<uint64_t> root_nb_visits; // [NB_MOVES], root children visits summed over workers, 0 outside of search
+
+	static uint8_t pick_weighted_faction(const std::array<uint8_t, NB_FACTIONS> &nb_units, const uint32_t total, SplitMix64 &random_generator)
+	{
+		uint32_t chosen_unit = random_generator.uniform(total);
+		uint8_t faction_i = 0;
+		for (; faction_i < NB_FACTIONS - 1; ++faction_i)
+		{
+			if(chosen_unit < nb_units[faction_i])
+			{
+				break;
+			}
+			chosen_unit -= nb_units[faction_i];
+		}
+		return faction_i;
+	}
+
+	// used by every hand inside the search, the discard depends on units the searching hand cannot see anyway
+	static uint8_t discard_random_unit(const std::array<uint8_t, NB_FACTIONS> &hand, SplitMix64 &random_generator)
+	{
+		uint32_t nb_units = 0;
+		for (const auto nb_faction_units : hand)
+		{
+			nb_units += nb_faction_units;
+		}
+		return pick_weighted_faction(hand, nb_units, random_generator);
+	}
+
+	/*
+	 * hands the units the game view does not show to the other hands, up to their known sizes, uniformly at random
+	 * what remains goes to the bag
+	 */
+	typename CorrespondingGameStateType::Snapshot determinize(const CorrespondingGameViewType &game_view, SplitMix64 &random_generator) const
+	{
+		typename CorrespondingGameStateType::Snapshot out;
+		out.hexagons = game_view.hexagons;
+		out.attack_zone = game_view.attack_zone;
+		out.rally_zone = game_view.rally_zone;
+		out.successive_negociation_counter = game_view.successive_negociation_counter;
+		out.winning_hand_idx = NB_HANDS;
+		out.hash = 0;
+		out.random_generator = SplitMix64{random_generator()};
+
+		std::array<uint8_t, NB_FACTIONS> hidden = {0};
+		uint32_t nb_hidden = 0;
+		for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
+		{
+			int16_t nb_faction_hidden = (
+				NB_PER_FACTION
+				- game_view.attack_zone[faction_i]
+				- game_view.rally_zone[faction_i]
+				- game_view.hand[faction_i]
+			);
+			for (uint8_t hexagon_i = 0; hexagon_i < NB_HEXAGONS; ++hexagon_i)
+			{
+				nb_faction_hidden -= game_view.hexagons[hexagon_i][faction_i];
+			}
+			if(nb_faction_hidden < 0)
+			{
+				panic("[ISMCTS.determinize]\tGame view shows more units than there are");
+			}
+
+			hidden[faction_i] = nb_faction_hidden;
+			nb_hidden += nb_faction_hidden;
+		}
+
+		for (uint8_t hand_i = 0; hand_i < NB_HANDS; ++hand_i)
+		{
+			out.hands[hand_i].fill(0);
+			if(hand_i == game_view.hand_idx)
+			{
+				out.hands[hand_i] = game_view.hand;
+				continue;
+			}
+
+			if(game_view.hand_sizes[hand_i] > nb_hidden)
+			{
+				panic("[ISMCTS.determinize]\tGame view hand sizes do not fit the hidden units");
+			}
+			for (uint8_t unit_i = 0; unit_i < game_view.hand_sizes[hand_i]; ++unit_i)
+			{
+				const uint8_t faction_idx = pick_weighted_faction(hidden, nb_hidden, random_generator);
+				++(out.hands[hand_i][faction_idx]);
+				--(hidden[faction_idx]);
+				--nb_hidden;
+			}
+		}
+		out.bag = hidden;
+
+		return out;
+	}
+
+	inline uint32_t add_node(Worker &worker, const uint32_t parent_idx, const MoveId move, const uint8_t hand_idx) const
+	{
+		const uint32_t node_idx = worker.arena.size();
+		worker.arena.push_back(Node{NO_NODE, NO_NODE, 0, 0, 0.f, move, hand_idx});
+		if(parent_idx != NO_NODE)
+		{
+			Node &parent = worker.arena[parent_idx];
+			worker.arena.back().next_sibling_idx = parent.first_child_idx;
+			parent.first_child_idx = node_idx;
+		}
+		return node_idx;
+	}
+
+	/*
+	 * one step down the tree from node_idx given the legal moves of the sample, returns the child to go to
+	 * expands a random untried legal move if there is one, picks the best ISUCT child otherwise
+	 */
+	uint32_t select_or_expand(Worker &worker, const uint32_t node_idx, const MoveId nb_moves, const uint8_t hand_idx, SplitMix64 &random_generator) const
+	{
+		for (MoveId move_i = 0; move_i < nb_moves; ++move_i)
+		{
+			worker.move_marks[worker.moves[move_i]] = UNTRIED;
+		}
+
+		uint32_t best_child_idx = NO_NODE;
+		float best_score = -1.f;
+		for (
+			uint32_t child_idx = worker.arena[node_idx].first_child_idx;
+			child_idx != NO_NODE;
+			child_idx = worker.arena[child_idx].next_sibling_idx
+		)
+		{
+			Node &child = worker.arena[child_idx];
+			if(worker.move_marks[child.move] == ILLEGAL)
+			{
+				continue;
+			}
+			worker.move_marks[child.move] = TRIED;
+			++(child.nb_availabilities);
+
+			const float score = (
+				child.total_reward / child.nb_visits
+				+ this->config.exploration * std::sqrt(std::log((float)child.nb_availabilities) / child.nb_visits)
+			);
+			if(score > best_score)
+			{
+				best_score = score;
+				best_child_idx = child_idx;
+			}
+		}
+
+		// compacting the untried moves at the front of the buffer, the marks are reset on the way
+		MoveId nb_untried = 0;
+		for (MoveId move_i = 0; move_i < nb_moves; ++move_i)
+		{
+			const MoveId move = worker.moves[move_i];
+			if(worker.move_marks[move] == UNTRIED)
+			{
+				worker.moves[nb_untried++] = move;
+			}
+			worker.move_marks[move] = ILLEGAL;
+		}
+
+		if(nb_untried > 0)
+		{
+			const MoveId move = worker.moves[random_generator.uniform(nb_untried)];
+			const uint32_t child_idx = this->add_node(worker, node_idx, move, hand_idx);
+			worker.arena[child_idx].nb_availabilities = 1;
+			return child_idx;
+		}
+		return best_child_idx;
+	}
+
+	void run_iteration(Worker &worker, const CorrespondingGameViewType &game_view, CorrespondingGameStateType &game_state, SplitMix64 &random_generator) const
+	{
+		// restoring twice to get the hash of the sample right, which is cheap next to the playout
+		auto sample = this->determinize(game_view, random_generator);
+		game_state.restore(sample);
+		sample.hash = game_state.compute_hash();
+		game_state.restore(sample);
+
+		const auto discard = [&random_generator](const std::array<uint8_t, NB_FACTIONS> &hand){
+			return discard_random_unit(hand, random_generator);
+		};
+
+		worker.path.clear();
+		uint32_t node_idx = 0;
+		uint8_t hand_idx = game_view.hand_idx;
+		bool is_in_tree = true;
+		while(game_state.get_successive_negociation_counter() < NB_HANDS)
+		{
+			const MoveId nb_moves = game_state.generate_legal_moves(hand_idx, worker.moves);
+			if(nb_moves == 0)
+			{
+				break;
+			}
+
+			MoveId move;
+			if(is_in_tree)
+			{
+				const uint32_t previous_nb_nodes = worker.arena.size();
+				node_idx = this->select_or_expand(worker, node_idx, nb_moves, hand_idx, random_generator);
+				worker.path.push_back(node_idx);
+				move = worker.arena[node_idx].move;
+				is_in_tree = (worker.arena.size() == previous_nb_nodes);
+			}
+			else
+			{
+				move = worker.moves[random_generator.uniform(nb_moves)];
+			}
+
+			game_state.make_move(hand_idx, move, discard);
+
+			++hand_idx;
+			hand_idx *= (hand_idx < NB_HANDS);
+		}
+
+		const uint8_t winning_hand_idx = game_state.get_winning_hand();
+		++(worker.arena[0].nb_visits);
+		for (const uint32_t path_node_idx : worker.path)
+		{
+			Node &node = worker.arena[path_node_idx];
+			++(node.nb_visits);
+			node.total_reward += (node.hand_idx == winning_hand_idx);
+		}
+	}
+
+	void run_worker(
+		Worker &worker,
+		const CorrespondingGameViewType &game_view,
+		const uint32_t nb_iterations,
+		const std::chrono::steady_clock::time_point deadline,
+		SplitMix64 random_generator
+	) const
+	{
+		worker.arena.clear();
+		worker.move_marks.resize(CorrespondingGameStateType::NB_MOVES, ILLEGAL);
+		worker.nb_iterations = 0;
+		this->add_node(worker, NO_NODE, 0, NB_HANDS);
+
+		// only the topology matters, every iteration restores a sample over it
+		auto game_state = CorrespondingGameStateType(this->topology, &this->factions_starting_point, (uint64_t)0);
+
+		const bool has_time_budget = this->config.time_budget_ms > 0;
+		while(nb_iterations == 0 || worker.nb_iterations < nb_iterations)
+		{
+			// checking the clock every few iterations keeps it off the profile
+			if(
+				has_time_budget
+				&& worker.nb_iterations > 0
+				&& worker.nb_iterations % 16 == 0
+				&& std::chrono::steady_clock::now() >= deadline
+			)
+			{
+				break;
+			}
+
+			this->run_iteration(worker, game_view, game_state, random_generator);
+			++(worker.nb_iterations);
+		}
+	}
+
+	// children of the root of every worker's tree, worker after worker
+	template<typename F>
+	void for_each_root_child(F &&fn) const
+	{
+		for (const auto &worker : this->workers)
+		{
+			for (
+				uint32_t child_idx = worker.arena.empty() ? NO_NODE : worker.arena[0].first_child_idx;
+				child_idx != NO_NODE;
+				child_idx = worker.arena[child_idx].next_sibling_idx
+			)
+			{
+				fn(worker.arena[child_idx]);
+			}
+		}
+	}
+
+public:
+	ISMCTS(
+		const CorrespondingBoardTopology &topology,
+		const std::array<uint8_t, NB_FACTIONS> &factions_starting_point,
+		const ISMCTSConfig &config
+	):
+	topology(topology),
+	factions_starting_point(factions_starting_point),
+	config(config),
+	workers(std::max(1u, config.nb_threads == 0 ? std::thread::hardware_concurrency() : config.nb_threads)),
+	random_generator{config.seed},
+	nb_searches(0),
+	root_nb_visits(CorrespondingMoveCodec::NB_MOVES, 0)
+	{
+		if(config.nb_iterations == 0 && config.time_budget_ms == 0)
+		{
+			panic("[ISMCTS]\tNeeds an iteration budget or a time budget");
+		}
+	}
+
+	// every legal move of game_view's hand is scored, returns the most visited one over all threads
+	MoveId search(const CorrespondingGameViewType &game_view)
+	{
+		if(game_view.successive_negociation_counter >= NB_HANDS)
+		{
+			panic("[ISMCTS.search]\tGame is already over");
+		}
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(this->config.time_budget_ms);
+		const SplitMix64 search_random_generator = SplitMix64{this->config.seed}.split(this->nb_searches++);
+		const uint32_t nb_workers = this->workers.size();
+
+		auto get_nb_worker_iterations = [this, nb_workers](const uint32_t worker_i) -> uint32_t {
+			if(this->config.nb_iterations == 0)
+			{
+				return 0;
+			}
+			// at least one each, so that every root has children
+			return std::max<uint32_t>(
+				1,
+				this->config.nb_iterations / nb_workers + (worker_i < this->config.nb_iterations % nb_workers)
+			);
+		};
+
+		// worker 0 runs on the calling thread, so that a single threaded search does not spawn any
+		std::vector<std::thread> threads;
+		for (uint32_t worker_i = 1; worker_i < nb_workers; ++worker_i)
+		{
+			threads.emplace_back(
+				[this, &game_view, &deadline, &search_random_generator, &get_nb_worker_iterations, worker_i](){
+					this->run_worker(
+						this->workers[worker_i],
+						game_view,
+						get_nb_worker_iterations(worker_i),
+						deadline,
+						search_random_generator.split(worker_i)
+					);
+				}
+			);
+		}
+		this->run_worker(this->workers[0], game_view, get_nb_worker_iterations(0), deadline, search_random_generator.split(0));
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+
+		// worker 0 always runs at least one iteration so its root has children unless nothing is legal
+		if(this->workers[0].arena[0].first_child_idx == NO_NODE)
+		{
+			panic("[ISMCTS.search]\tNo legal move to search");
+		}
+
+		// summing root children by move, then picking the most visited, first met in worker order on ties
+		this->for_each_root_child([this](const Node &root_child){
+			this->root_nb_visits[root_child.move] += root_child.nb_visits;
+		});
+
+		MoveId best_move = this->workers[0].arena[this->workers[0].arena[0].first_child_idx].move;
+		uint64_t best_nb_visits = 0;
+		this->for_each_root_child([this, &best_move, &best_nb_visits](const Node &root_child){
+			if(this->root_nb_visits[root_child.move] > best_nb_visits)
+			{
+				best_nb_visits = this->root_nb_visits[root_child.move];
+				best_move = root_child.move;
+			}
+		});
+
+		this->for_each_root_child([this](const Node &root_child){
+			this->root_nb_visits[root_child.move] = 0;
+		});
+		return best_move;
+	}
+
+	// children of the root of worker_idx's tree after the last search
+	std::vector<Node> get_root_children(const uint32_t worker_idx) const
+	{
+		std::vector<Node> out;
+		const auto &arena = this->workers[worker_idx].arena;
+		for (
+			uint32_t child_idx = arena.empty() ? NO_NODE : arena[0].first_child_idx;
+			child_idx != NO_NODE;
+			child_idx = arena[child_idx].next_sibling_idx
+		)
+		{
+			out.push_back(arena[child_idx]);
+		}
+		return out;
+	}
+
+	// number of iterations of the last search, over all threads
+	uint64_t get_nb_iterations(void) const
+	{
+		uint64_t out = 0;
+		for (const auto &worker : this->workers)
+		{
+			out += worker.nb_iterations;
+		}
+		return out;
+	}
+
+	inline CorrespondingOrderType get_order(const CorrespondingGameViewType game_view)
+	{
+		return CorrespondingMoveCodec::decode(this->search(game_view));
+	}
+
+	inline CorrespondingOrderType get_order(const CorrespondingGameStateViewType &game_state_view)
+	{
+		return this->get_order(game_state_view.to_game_view());
+	}
+
+	inline uint8_t pick_discarded_faction(const std::array<uint8_t, NB_FACTIONS> &hand)
+	{
+		return discard_random_unit(hand, this->random_generator);
+	}
+};
+
+} // Turncoat
+#endif // ISMCTS_HXX
@@ -0,0 +1,172 @@
+#pragma once
+#ifndef MOVE_HXX
+#define MOVE_HXX
+
+#include <cstdint>
+
+#include "./order.hxx"
+
+namespace Turncoat
+{
+
+// compact order encoding: a dense index in [0, NB_MOVES), laid out as [negociate | deploys | attacks | rallies]
+using MoveId = uint32_t;
+
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION
+>
+struct MoveCodec
+{
+	using CorrespondingOrderType = Order<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION>;
+
+	// unit counts go from 0 to NB_PER_FACTION - 1, same as Order::is_valid_unit_nb
+	static constexpr uint64_t NB_NEGOCIATE_MOVES = 1;
+	static constexpr uint64_t NB_DEPLOY_MOVES = (uint64_t)NB_FACTIONS * NB_HEXAGONS;
+	static constexpr uint64_t NB_ATTACK_MOVES = (uint64_t)NB_FACTIONS * NB_FACTIONS * NB_PER_FACTION * NB_HEXAGONS;
+	static constexpr uint64_t NB_RALLY_MOVES = (uint64_t)NB_FACTIONS * NB_PER_FACTION * NB_HEXAGONS * NB_HEXAGONS;
+
+	static_assert(
+		NB_NEGOCIATE_MOVES + NB_DEPLOY_MOVES + NB_ATTACK_MOVES + NB_RALLY_MOVES <= UINT32_MAX,
+		"game too big for MoveId"
+	);
+
+	static constexpr MoveId NEGOCIATE_OFFSET = 0;
+	static constexpr MoveId DEPLOY_OFFSET = NEGOCIATE_OFFSET + NB_NEGOCIATE_MOVES;
+	static constexpr MoveId ATTACK_OFFSET = DEPLOY_OFFSET + NB_DEPLOY_MOVES;
+	static constexpr MoveId RALLY_OFFSET = ATTACK_OFFSET + NB_ATTACK_MOVES;
+	static constexpr MoveId NB_MOVES = RALLY_OFFSET + NB_RALLY_MOVES;
+
+	static constexpr MoveId encode_negociate(void)
+	{
+		return NEGOCIATE_OFFSET;
+	}
+
+	static constexpr MoveId encode_deploy(const uint8_t faction_idx, const uint8_t hexagon_idx)
+	{
+		return DEPLOY_OFFSET + (MoveId)faction_idx * NB_HEXAGONS + hexagon_idx;
+	}
+
+	static constexpr MoveId encode_attack(
+		const uint8_t atking_faction_idx,
+		const uint8_t atked_faction_idx,
+		const uint8_t nb_atked_units,
+		const uint8_t hexagon_idx
+	)
+	{
+		return ATTACK_OFFSET + (
+			(((MoveId)atking_faction_idx * NB_FACTIONS + atked_faction_idx) * NB_PER_FACTION + nb_atked_units)
+			* NB_HEXAGONS
+			+ hexagon_idx
+		);
+	}
+
+	static constexpr MoveId encode_rally(
+		const uint8_t faction_idx,
+		const uint8_t nb_units,
+		const uint8_t start_hexagon_idx,
+		const uint8_t end_hexagon_idx
+	)
+	{
+		return RALLY_OFFSET + (
+			(((MoveId)faction_idx * NB_PER_FACTION + nb_units) * NB_HEXAGONS + start_hexagon_idx)
+			* NB_HEXAGONS
+			+ end_hexagon_idx
+		);
+	}
+
+	// assumes order.is_valid()
+	static MoveId encode(const CorrespondingOrderType &order)
+	{
+		switch(order.order_type)
+		{
+			case ATTACK:
+				return encode_attack(
+					order.atking_faction_idx,
+					order.atked_faction_idx,
+					order.nb_atked_units,
+					order.hexagon_idx
+				);
+
+			case DEPLOY:
+				return encode_deploy(order.faction_idx, order.hexagon_idx);
+
+			case RALLY:
+				return encode_rally(
+					order.faction_idx,
+					order.nb_units,
+					order.start_hexagon_idx,
+					order.end_hexagon_idx
+				);
+
+			case NEGOCIATE:
+			default:
+				return encode_negociate();
+		}
+	}
+
+	static constexpr OrderType get_order_type(const MoveId move)
+	{
+		if(move < DEPLOY_OFFSET)
+		{
+			return NEGOCIATE;
+		}
+		if(move < ATTACK_OFFSET)
+		{
+			return DEPLOY;
+		}
+		if(move < RALLY_OFFSET)
+		{
+			return ATTACK;
+		}
+		return RALLY;
+	}
+
+	// assumes move < NB_MOVES
+	static CorrespondingOrderType decode(const MoveId move)
+	{
+		switch(get_order_type(move))
+		{
+			case DEPLOY:
+			{
+				const MoveId x = move - DEPLOY_OFFSET;
+				return CorrespondingOrderType(
+					(uint8_t)(x / NB_HEXAGONS),
+					(uint8_t)(x % NB_HEXAGONS)
+				);
+			}
+
+			case ATTACK:
+			{
+				MoveId x = move - ATTACK_OFFSET;
+				const uint8_t hexagon_idx = x % NB_HEXAGONS;
+				x /= NB_HEXAGONS;
+				const uint8_t nb_atked_units = x % NB_PER_FACTION;
+				x /= NB_PER_FACTION;
+				const uint8_t atked_faction_idx = x % NB_FACTIONS;
+				const uint8_t atking_faction_idx = x / NB_FACTIONS;
+				return CorrespondingOrderType(atking_faction_idx, atked_faction_idx, nb_atked_units, hexagon_idx);
+			}
+
+			case RALLY:
+			{
+				MoveId x = move - RALLY_OFFSET;
+				const uint8_t end_hexagon_idx = x % NB_HEXAGONS;
+				x /= NB_HEXAGONS;
+				const uint8_t start_hexagon_idx = x % NB_HEXAGONS;
+				x /= NB_HEXAGONS;
+				const uint8_t nb_units = x % NB_PER_FACTION;
+				const uint8_t faction_idx = x / NB_PER_FACTION;
+				return CorrespondingOrderType(RALLY, faction_idx, nb_units, start_hexagon_idx, end_hexagon_idx);
+			}
+
+			case NEGOCIATE:
+			default:
+				return CorrespondingOrderType();
+		}
+	}
+};
+
+} // Turncoat
+#endif // MOVE_HXX
@@ -0,0 +1,33 @@
+#pragma once
+#ifndef OBSERVATION_HXX
+#define OBSERVATION_HXX
+
+#include <cstdint>
+
+namespace Turncoat
+{
+
+/*
+ * observation of the hand to play, one byte per entry, as VecGameEnv hands it out and game records store it:
+ * hexagons, own hand, attack zone, rally zone, every hand size, hand idx, negociation counter, pending discard
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_HANDS
+>
+struct ObservationLayout
+{
+	static constexpr uint32_t HEXAGONS_OFFSET = 0;
+	static constexpr uint32_t HAND_OFFSET = HEXAGONS_OFFSET + NB_HEXAGONS * NB_FACTIONS;
+	static constexpr uint32_t ATTACK_ZONE_OFFSET = HAND_OFFSET + NB_FACTIONS;
+	static constexpr uint32_t RALLY_ZONE_OFFSET = ATTACK_ZONE_OFFSET + NB_FACTIONS;
+	static constexpr uint32_t HAND_SIZES_OFFSET = RALLY_ZONE_OFFSET + NB_FACTIONS;
+	static constexpr uint32_t PLAYER_OFFSET = HAND_SIZES_OFFSET + NB_HANDS;
+	static constexpr uint32_t NEGOCIATION_COUNTER_OFFSET = PLAYER_OFFSET + 1;
+	static constexpr uint32_t PENDING_DISCARD_OFFSET = NEGOCIATION_COUNTER_OFFSET + 1;
+	static constexpr uint32_t SIZE = PENDING_DISCARD_OFFSET + 1;
+};
+
+} // Turncoat
+#endif // OBSERVATION_HXX
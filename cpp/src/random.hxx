@@ -0,0 +1,55 @@
+#pragma once
+#ifndef RANDOM_HXX
+#define RANDOM_HXX
+
+#include <cstdint>
+#include <limits>
+
+namespace Turncoat
+{
+
+/*
+ * tiny trivially copyable generator (SplitMix64) so that every game state carries its own random state
+ * copying a state copies its future draws, which is what snapshots and undo records rely on
+ */
+struct SplitMix64
+{
+	using result_type = uint64_t;
+
+	uint64_t state;
+
+	static constexpr result_type min(void)
+	{
+		return std::numeric_limits<result_type>::min();
+	}
+
+	static constexpr result_type max(void)
+	{
+		return std::numeric_limits<result_type>::max();
+	}
+
+	constexpr result_type operator()(void)
+	{
+		uint64_t z = (this->state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	// independent generator for the given stream, same (state, stream_idx) always giving the same one
+	constexpr SplitMix64 split(const uint64_t stream_idx) const
+	{
+		SplitMix64 mixer{this->state ^ (stream_idx * 0xD1B54A32D192ED03ULL)};
+		mixer();
+		return SplitMix64{mixer()};
+	}
+
+	// uniform in [0, bound), bound must fit in 32 bits
+	constexpr uint32_t uniform(const uint32_t bound)
+	{
+		return (uint32_t)((((*this)() >> 32) * bound) >> 32);
+	}
+};
+
+} // Turncoat
+#endif // RANDOM_HXX
@@ -0,0 +1,345 @@
+#pragma once
+#ifndef SELFPLAY_HXX
+#define SELFPLAY_HXX
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "./gamestate.hxx"
+#include "./move.hxx"
+#include "./random.hxx"
+#include "./util.hxx"
+
+namespace Turncoat
+{
+
+struct PolicyResult
+{
+	std::string name;
+	uint64_t nb_games; // games it took at least one seat of
+	uint64_t nb_seats; // a policy can fill several seats of the same game
+	uint64_t nb_wins;
+
+	// per seat
+	double get_win_rate(void) const
+	{
+		return (this->nb_seats == 0) ? 0. : (double)this->nb_wins / this->nb_seats;
+	}
+
+	/*
+	 * wilson score interval of the per seat win rate, z = 1.96 gives 95% confidence
+	 * the seats of one game are not independent trials, at most one of them wins, so the interval is taken over games,
+	 * which are, then scaled by the number of games per seat, which the seating rotation fixes
+	 */
+	std::array<double, 2> get_confidence_interval(const double z = 1.96) const
+	{
+		if(this->nb_games == 0)
+		{
+			return {0., 1.};
+		}
+
+		const double n = this->nb_games;
+		const double p = (double)this->nb_wins / this->nb_games;
+		const double denominator = 1. + z * z / n;
+		const double center = (p + z * z / (2. * n)) / denominator;
+		const double half_width = z * std::sqrt(p * (1. - p) / n + z * z / (4. * n * n)) / denominator;
+		const double nb_games_per_seat = (double)this->nb_games / this->nb_seats;
+
+		return {(center - half_width) * nb_games_per_seat, (center + half_width) * nb_games_per_seat};
+	}
+};
+
+struct SelfPlayResults
+{
+	uint64_t nb_games;
+	uint64_t nb_turns;
+	std::vector<PolicyResult> policies;
+};
+
+/*
+ * plays many complete games across threads, each policy being native code picking among the legal moves
+ *
+ * game i only depends on the master seed and i: its state and its policies draw from generators split from the master seed,
+ * so results are the same whatever the number of threads. seat s of game i is taken by policy (i + s) % nb_policies
+ *
+ * threads grab batches of consecutive games from a shared counter until none is left, so that fast threads take over the work of slow ones
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_HANDS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+class SelfPlayRunner
+{
+public:
+	using CorrespondingGameStateType = GameState<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingMoveCodec = typename CorrespondingGameStateType::CorrespondingMoveCodec;
+	using MoveBuffer = typename CorrespondingGameStateType::MoveBuffer;
+
+	struct Policy
+	{
+		std::string name;
+
+		// moves[0, nb_moves) are the legal moves, nb_moves > 0
+		MoveId (*pick_move)(
+			const CorrespondingGameStateType &game_state,
+			const uint8_t hand_idx,
+			const MoveBuffer &moves,
+			const MoveId nb_moves,
+			SplitMix64 &random_generator
+		);
+
+		// called with the hand after the negociation draw, has to return a faction present in hand
+		uint8_t (*pick_discarded_faction)(
+			const std::array<uint8_t, NB_FACTIONS> &hand,
+			SplitMix64 &random_generator
+		);
+	};
+
+	static MoveId pick_random_move(
+		const CorrespondingGameStateType &,
+		const uint8_t,
+		const MoveBuffer &moves,
+		const MoveId nb_moves,
+		SplitMix64 &random_generator
+	)
+	{
+		return moves[random_generator.uniform(nb_moves)];
+	}
+
+	// generate_legal_moves always lists the negociation first when there is one
+	static MoveId pick_negociate_move(
+		const CorrespondingGameStateType &,
+		const uint8_t,
+		const MoveBuffer &moves,
+		const MoveId,
+		SplitMix64 &
+	)
+	{
+		return moves[0];
+	}
+
+	static uint8_t discard_random_faction(const std::array<uint8_t, NB_FACTIONS> &hand, SplitMix64 &random_generator)
+	{
+		uint8_t nb_units = 0;
+		for (const auto nb_faction_units : hand)
+		{
+			nb_units += nb_faction_units;
+		}
+
+		uint8_t chosen_unit = random_generator.uniform(nb_units);
+		uint8_t faction_i = 0;
+		for (; faction_i < NB_FACTIONS; ++faction_i)
+		{
+			if(chosen_unit < hand[faction_i])
+			{
+				break;
+			}
+			chosen_unit -= hand[faction_i];
+		}
+		return faction_i;
+	}
+
+	static uint8_t discard_first_possible(const std::array<uint8_t, NB_FACTIONS> &hand, SplitMix64 &)
+	{
+		for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
+		{
+			if(hand[faction_i] > 0)
+			{
+				return faction_i;
+			}
+		}
+		return NB_FACTIONS;
+	}
+
+	static const std::vector<Policy> &get_builtin_policies(void)
+	{
+		static const std::vector<Policy> builtin_policies = {
+			{"random", &pick_random_move, &discard_random_faction},
+			{"negociate", &pick_negociate_move, &discard_first_possible},
+		};
+		return builtin_policies;
+	}
+
+	static Policy get_builtin_policy(const std::string &name)
+	{
+		for (const auto &policy : get_builtin_policies())
+		{
+			if(policy.name == name)
+			{
+				return policy;
+			}
+		}
+		throw std::invalid_argument("[SelfPlayRunner.get_builtin_policy]\tUnknown policy " + name);
+	}
+
+protected:
+	const typename CorrespondingGameStateType::CorrespondingBoardTopology topology;
+	const std::array<uint8_t, NB_FACTIONS> factions_starting_point;
+
+	const std::vector<Policy> policies;
+
+public:
+	SelfPlayRunner(
+		const std::array<std::array<bool, NB_HEXAGONS>, NB_HEXAGONS> &adjacency_graph,
+		const std::array<uint8_t, NB_FACTIONS> &factions_starting_point,
+		const std::unordered_set<uint8_t> &unreachable_hexagons,
+		const std::vector<Policy> &policies
+	):
+	topology(CorrespondingGameStateType::CorrespondingBoardTopology::from_adjacency_graph(adjacency_graph, unreachable_hexagons)),
+	factions_starting_point(factions_starting_point),
+	policies(policies)
+	{
+		if(policies.empty())
+		{
+			throw std::invalid_argument("[SelfPlayRunner]\tNeeds at least one policy");
+		}
+	}
+
+	inline const Policy &get_seat_policy(const uint64_t game_idx, const uint8_t hand_idx) const
+	{
+		return this->policies[(game_idx + hand_idx) % this->policies.size()];
+	}
+
+	/*
+	 * plays game game_idx to the end, returns the winning hand and adds the number of turns played to nb_turns
+	 * a hand without any legal move (empty hand and empty bag) ends the game
+	 */
+	uint8_t play_game(const uint64_t master_seed, const uint64_t game_idx, uint64_t &nb_turns) const
+	{
+		SplitMix64 game_random_generator = SplitMix64{master_seed}.split(game_idx);
+		SplitMix64 policies_random_generator = game_random_generator.split(0);
+
+		auto game_state = CorrespondingGameStateType(
+			this->topology,
+			&this->factions_starting_point,
+			game_random_generator()
+		);
+
+		MoveBuffer moves;
+		uint8_t hand_idx = 0;
+		while(game_state.get_successive_negociation_counter() < NB_HANDS)
+		{
+			const auto nb_moves = game_state.generate_legal_moves(hand_idx, moves);
+			if(nb_moves == 0)
+			{
+				break;
+			}
+
+			const auto &policy = this->get_seat_policy(game_idx, hand_idx);
+			const auto move = policy.pick_move(game_state, hand_idx, moves, nb_moves, policies_random_generator);
+
+			const auto undo_record = game_state.make_move(
+				hand_idx,
+				move,
+				[&policy, &policies_random_generator](const std::array<uint8_t, NB_FACTIONS> &hand){
+					return policy.pick_discarded_faction(hand, policies_random_generator);
+				}
+			);
+			if(
+				CorrespondingMoveCodec::get_order_type(move) == NEGOCIATE
+				&& undo_record.discarded_faction_idx == NB_FACTIONS
+			)
+			{
+				panic("[SelfPlayRunner.play_game]\tPolicy " + policy.name + " discarded a faction absent from hand");
+			}
+
+			++nb_turns;
+			++hand_idx;
+			hand_idx *= (hand_idx < NB_HANDS);
+		}
+
+		return game_state.get_winning_hand();
+	}
+
+	// nb_threads == 0 uses every core
+	SelfPlayResults run(
+		const uint64_t nb_games,
+		const uint64_t master_seed,
+		uint32_t nb_threads = 0,
+		const uint64_t nb_games_per_batch = 64
+	) const
+	{
+		if(nb_threads == 0)
+		{
+			nb_threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		SelfPlayResults results{0, 0, {}};
+		for (const auto &policy : this->policies)
+		{
+			results.policies.push_back({policy.name, 0, 0, 0});
+		}
+
+		const uint64_t nb_batches = (nb_games + nb_games_per_batch - 1) / nb_games_per_batch;
+		std::atomic<uint64_t> next_batch_idx(0);
+		std::mutex results_mutex;
+
+		auto worker = [&](){
+			std::vector<uint64_t> nb_policy_games(this->policies.size(), 0);
+			std::vector<uint64_t> nb_seats(this->policies.size(), 0);
+			std::vector<uint64_t> nb_wins(this->policies.size(), 0);
+			uint64_t nb_turns = 0;
+			uint64_t nb_played_games = 0;
+
+			for (
+				uint64_t batch_idx = next_batch_idx.fetch_add(1, std::memory_order_relaxed);
+				batch_idx < nb_batches;
+				batch_idx = next_batch_idx.fetch_add(1, std::memory_order_relaxed)
+			)
+			{
+				const uint64_t end_game_idx = std::min(nb_games, (batch_idx + 1) * nb_games_per_batch);
+				for (uint64_t game_idx = batch_idx * nb_games_per_batch; game_idx < end_game_idx; ++game_idx)
+				{
+					const uint8_t winning_hand_idx = this->play_game(master_seed, game_idx, nb_turns);
+
+					// seats rotate over the policies, so the first nb_policies seats are the ones taken by distinct policies
+					for (uint8_t hand_i = 0; hand_i < NB_HANDS; ++hand_i)
+					{
+						nb_policy_games[(game_idx + hand_i) % this->policies.size()] += (hand_i < this->policies.size());
+						++(nb_seats[(game_idx + hand_i) % this->policies.size()]);
+					}
+					++(nb_wins[(game_idx + winning_hand_idx) % this->policies.size()]);
+					++nb_played_games;
+				}
+			}
+
+			const std::lock_guard<std::mutex> lock(results_mutex);
+			results.nb_games += nb_played_games;
+			results.nb_turns += nb_turns;
+			for (size_t policy_i = 0; policy_i < this->policies.size(); ++policy_i)
+			{
+				results.policies[policy_i].nb_games += nb_policy_games[policy_i];
+				results.policies[policy_i].nb_seats += nb_seats[policy_i];
+				results.policies[policy_i].nb_wins += nb_wins[policy_i];
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (uint32_t thread_i = 1; thread_i < nb_threads; ++thread_i)
+		{
+			threads.emplace_back(worker);
+		}
+		worker();
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+
+		return results;
+	}
+};
+
+} // Turncoat
+#endif // SELFPLAY_HXX
@@ -0,0 +1,318 @@
+#pragma once
+#ifndef STATICGAMEHANDLER_HXX
+#define STATICGAMEHANDLER_HXX
+
+#include <array>
+#include <random>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+
+#include "./gamerecord.hxx"
+#include "./gamestate.hxx"
+#include "./gamestateview.hxx"
+#include "./order.hxx"
+#include "./stats.hxx"
+#include "./util.hxx"
+
+namespace Turncoat
+{
+
+/*
+ * GameHandler without type erasure: the policy of every seat is a template parameter, so that its calls can be inlined
+ * a policy is any type with
+ * 	Order get_order(const GameStateView &game_state_view)
+ * 	uint8_t pick_discarded_faction(const std::array<uint8_t, NB_FACTIONS> &hand)
+ * and gets a view of the game state instead of a copy of what it can see
+ * policies are held by value, a reference type can be given to share one with the caller (such as an ISMCTS and its arenas)
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_PLAYERS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS,
+	typename... Policies
+>
+class StaticGameHandler
+{
+	static_assert(sizeof...(Policies) == NB_PLAYERS, "StaticGameHandler needs one policy per player");
+
+public:
+	using CorrespondingGameStateType = GameState<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingGameStateViewType = GameStateView<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingOrderType = Order<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION>;
+	using CorrespondingMoveCodec = typename CorrespondingGameStateType::CorrespondingMoveCodec;
+	using CorrespondingGameRecordWriterType = GameRecordWriter<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingGameRecordFormat = typename CorrespondingGameRecordWriterType::CorrespondingFormat;
+	using PoliciesType = std::tuple<Policies...>;
+
+protected:
+	// what the game state was built from, kept for the game records
+	uint64_t seed;
+
+	CorrespondingGameStateType game_state;
+
+	std::tuple<Policies...> policies;
+
+	uint8_t current_player_idx;
+
+	// nullptr when not recording
+	CorrespondingGameRecordWriterType *game_record_writer;
+
+	// unrolled into a chain of comparisons, each calling its seat's policy directly
+	template<uint8_t SEAT_IDX = 0>
+	inline CorrespondingOrderType get_order_from_seat(const uint8_t player_idx, const CorrespondingGameStateViewType &game_state_view)
+	{
+		if constexpr (SEAT_IDX + 1 < NB_PLAYERS)
+		{
+			if(player_idx != SEAT_IDX)
+			{
+				return this->get_order_from_seat<SEAT_IDX + 1>(player_idx, game_state_view);
+			}
+		}
+		return std::get<SEAT_IDX>(this->policies).get_order(game_state_view);
+	}
+
+	template<uint8_t SEAT_IDX = 0>
+	inline uint8_t pick_discarded_faction_from_seat(const uint8_t player_idx, const std::array<uint8_t, NB_FACTIONS> &hand)
+	{
+		if constexpr (SEAT_IDX + 1 < NB_PLAYERS)
+		{
+			if(player_idx != SEAT_IDX)
+			{
+				return this->pick_discarded_faction_from_seat<SEAT_IDX + 1>(player_idx, hand);
+			}
+		}
+		return std::get<SEAT_IDX>(this->policies).pick_discarded_faction(hand);
+	}
+
+	inline CorrespondingOrderType get_order_from_player(const uint8_t player_idx)
+	{
+		const CorrespondingGameStateViewType game_state_view(this->game_state, player_idx);
+
+		while(true)
+		{
+			const auto current_order = this->get_order_from_seat(player_idx, game_state_view);
+
+			if(current_order.is_valid())
+			{
+				return current_order;
+			}
+
+			LOG_ERR(
+				"[StaticGameHandler.get_order_from_player]\tWarning: was given invalid order by player $"
+				<< (int)player_idx
+			);
+		}
+	}
+
+public:
+	StaticGameHandler(
+		const std::array<std::array<bool, NB_HEXAGONS>, NB_HEXAGONS> *adjacency_graph,
+		const std::array<uint8_t, NB_FACTIONS> *factions_starting_point,
+		const std::unordered_set<uint8_t> *unreachable_hexagons,
+		std::mt19937 *random_generator,
+		const std::tuple<Policies...> &policies
+	):
+	seed(CorrespondingGameStateType::seed_from(random_generator)),
+	game_state(adjacency_graph, factions_starting_point, unreachable_hexagons, this->seed),
+	policies(policies),
+	current_player_idx(0),
+	game_record_writer(nullptr)
+	{}
+
+	// the game, including the random tie break of get_winner, only depends on seed and the policies
+	StaticGameHandler(
+		const std::array<std::array<bool, NB_HEXAGONS>, NB_HEXAGONS> *adjacency_graph,
+		const std::array<uint8_t, NB_FACTIONS> *factions_starting_point,
+		const std::unordered_set<uint8_t> *unreachable_hexagons,
+		const uint64_t seed,
+		const std::tuple<Policies...> &policies
+	):
+	seed(seed),
+	game_state(adjacency_graph, factions_starting_point, unreachable_hexagons, seed),
+	policies(policies),
+	current_player_idx(0),
+	game_record_writer(nullptr)
+	{}
+
+	StaticGameHandler(
+		const typename CorrespondingGameStateType::CorrespondingBoardTopology &topology,
+		const std::array<uint8_t, NB_FACTIONS> *factions_starting_point,
+		const uint64_t seed,
+		const std::tuple<Policies...> &policies
+	):
+	seed(seed),
+	game_state(topology, factions_starting_point, seed),
+	policies(policies),
+	current_player_idx(0),
+	game_record_writer(nullptr)
+	{}
+
+	/*
+	 * every order which changes the game from now on goes to game_record_writer, which gets the game ended once it is over
+	 * meant to be called before the first turn, the record is replayed from the beginning of the game
+	 * game_record_writer has to outlive the game, or at least its end
+	 */
+	void start_recording(CorrespondingGameRecordWriterType &game_record_writer)
+	{
+		game_record_writer.begin_game(this->seed);
+		this->game_record_writer = &game_record_writer;
+	}
+
+	// returns whether order was successfully executed
+	bool run_turn(void)
+	{
+		// the observation is the one before the order, so it has to be taken now
+		std::array<uint8_t, CorrespondingGameRecordFormat::OBS_SIZE> observation;
+		if(this->game_record_writer != nullptr && this->game_record_writer->has_observations())
+		{
+			CorrespondingGameRecordFormat::write_observation(
+				CorrespondingGameStateViewType(this->game_state, this->current_player_idx),
+				observation.data()
+			);
+		}
+
+		const auto current_order = this->get_order_from_player(this->current_player_idx);
+		bool order_succeeded = false;
+		uint8_t discarded_faction_idx = NB_FACTIONS + 1; // stays so if the picker is not called
+		switch(current_order.order_type)
+		{
+			case ATTACK:
+				order_succeeded = this->game_state.attack(
+					this->current_player_idx,
+					current_order.atking_faction_idx,
+					current_order.atked_faction_idx,
+					current_order.nb_atked_units,
+					current_order.hexagon_idx
+				);
+				break;
+
+			case DEPLOY:
+				order_succeeded = this->game_state.deploy(
+					this->current_player_idx,
+					current_order.faction_idx,
+					current_order.hexagon_idx
+				);
+				break;
+
+			case NEGOCIATE:
+				order_succeeded = this->game_state.negociate(
+					this->current_player_idx,
+					[this, &discarded_faction_idx](const std::array<uint8_t, NB_FACTIONS> &hand){
+						discarded_faction_idx = this->pick_discarded_faction_from_seat(this->current_player_idx, hand);
+						return discarded_faction_idx;
+					}
+				);
+				break;
+
+			case RALLY:
+				order_succeeded = this->game_state.rally(
+					this->current_player_idx,
+					current_order.faction_idx,
+					current_order.nb_units,
+					current_order.start_hexagon_idx,
+					current_order.end_hexagon_idx
+				);
+				break;
+
+			default:
+				panic("[StaticGameHandler.run_turn]\tImpossible state detected: given order of unknown type");
+				return false;
+		}
+
+		if(this->game_record_writer != nullptr)
+		{
+			if(order_succeeded)
+			{
+				this->game_record_writer->add_step(CorrespondingMoveCodec::encode(current_order), discarded_faction_idx, observation.data());
+			}
+			else if(discarded_faction_idx != NB_FACTIONS + 1)
+			{
+				// the negociation drew from the bag, which replays have to do as well
+				this->game_record_writer->add_step(CorrespondingMoveCodec::encode_negociate(), NB_FACTIONS, observation.data());
+			}
+		}
+
+		if (!order_succeeded)
+		{
+			return false;
+		}
+
+		++(this->current_player_idx);
+		this->current_player_idx *= (this->current_player_idx < NB_PLAYERS);
+
+		if(this->game_state.get_successive_negociation_counter() == NB_PLAYERS)
+		{
+			TURNCOAT_COUNT(GAMES);
+			if(this->game_record_writer != nullptr)
+			{
+				this->game_record_writer->end_game();
+				this->game_record_writer = nullptr;
+			}
+		}
+
+		return true;
+	}
+
+	void run_all_turns(void)
+	{
+		while(this->game_state.get_successive_negociation_counter() != NB_PLAYERS)
+		{
+			if(!this->run_turn())
+			{
+				LOG_ERR("[StaticGameHandler.run_all_turns]\tOrder failed!");
+			}
+		}
+	}
+
+	uint8_t get_winner(void)
+	{
+		return this->game_state.get_winning_hand();
+	}
+
+	const CorrespondingGameStateType &get_game_state(void) const
+	{
+		return this->game_state;
+	}
+};
+
+template<typename T, size_t>
+using Repeated = T;
+
+// only declared, to expand a policy NB_PLAYERS times in UniformStaticGameHandler
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_PLAYERS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS,
+	typename Policy,
+	size_t... SEAT_IDXS
+>
+StaticGameHandler<
+	NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS,
+	Repeated<Policy, SEAT_IDXS>...
+> repeat_policy(std::index_sequence<SEAT_IDXS...>);
+
+// every seat has the same policy type, such as in rollouts
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_PLAYERS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS,
+	typename Policy
+>
+using UniformStaticGameHandler = decltype(
+	repeat_policy<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_PLAYERS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS, Policy>(
+		std::make_index_sequence<NB_PLAYERS>{}
+	)
+);
+
+} // Turncoat
+#endif // STATICGAMEHANDLER_HXX
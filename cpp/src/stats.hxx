@@ -0,0 +1,213 @@
+#pragma once
+#ifndef STATS_HXX
+#define STATS_HXX
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "./order.hxx"
+
+/*
+ * define TURNCOAT_STATS to count what the engine does, read back with Turncoat::get_stats()
+ * without it every TURNCOAT_COUNT compiles to nothing and get_stats() stays at zero
+ * counters are per thread, so that counting never contends, and summed when read
+ * only the checked orders and game handlers count: what search, self-play and replays play through make_move is not game play
+ */
+#ifdef TURNCOAT_STATS
+#define TURNCOAT_COUNT(COUNTER) ::Turncoat::count_stat(::Turncoat::StatsCounter::COUNTER)
+#define TURNCOAT_COUNT_NEGOCIATION_STREAK(LENGTH) ::Turncoat::count_negociation_streak(LENGTH)
+#else
+#define TURNCOAT_COUNT(COUNTER)
+#define TURNCOAT_COUNT_NEGOCIATION_STREAK(LENGTH)
+#endif // TURNCOAT_STATS
+
+namespace Turncoat
+{
+
+#ifdef TURNCOAT_STATS
+constexpr bool STATS_ENABLED = true;
+#else
+constexpr bool STATS_ENABLED = false;
+#endif // TURNCOAT_STATS
+
+enum StatsCounter : uint8_t
+{
+	FAILED_ATTACKS,
+	FAILED_DEPLOYS,
+	FAILED_NEGOCIATIONS,
+	FAILED_RALLIES,
+	BAG_DRAWS, // by negociations, setting up a game is not counted
+	TURNS, // every successful checked order (attack, rally, deploy, negociate, apply), make_move is not counted
+	GAMES, // played to the end through StaticGameHandler::run_turn
+	NB_STATS_COUNTERS
+};
+
+// longer streaks are counted with this length, they can only happen with as many hands
+constexpr uint8_t MAX_NEGOCIATION_STREAK = 16;
+
+struct Stats
+{
+	std::array<uint64_t, NB_STATS_COUNTERS> counters;
+
+	// number of negociation streaks per length, a streak ends with any other order or with the game
+	std::array<uint64_t, MAX_NEGOCIATION_STREAK + 1> negociation_streaks;
+
+	inline uint64_t get(const StatsCounter counter) const
+	{
+		return this->counters[counter];
+	}
+
+	uint64_t get_nb_failed_orders(const OrderType order_type) const
+	{
+		switch(order_type)
+		{
+			case ATTACK:
+				return this->get(FAILED_ATTACKS);
+			case DEPLOY:
+				return this->get(FAILED_DEPLOYS);
+			case NEGOCIATE:
+				return this->get(FAILED_NEGOCIATIONS);
+			case RALLY:
+				return this->get(FAILED_RALLIES);
+			default:
+				return 0;
+		}
+	}
+
+	// turns per game, which is only meaningful if every game was played through StaticGameHandler
+	double get_average_game_length(void) const
+	{
+		return (this->get(GAMES) == 0) ? 0. : (double)this->get(TURNS) / this->get(GAMES);
+	}
+
+	double get_average_negociation_streak(void) const
+	{
+		uint64_t nb_streaks = 0;
+		uint64_t nb_negociations = 0;
+		for (uint8_t length_i = 1; length_i <= MAX_NEGOCIATION_STREAK; ++length_i)
+		{
+			nb_streaks += this->negociation_streaks[length_i];
+			nb_negociations += length_i * this->negociation_streaks[length_i];
+		}
+		return (nb_streaks == 0) ? 0. : (double)nb_negociations / nb_streaks;
+	}
+};
+
+// what one thread counted, written by that thread only, relaxed atomics so that reading it from another one is not a race
+struct ThreadStats
+{
+	std::array<std::atomic<uint64_t>, NB_STATS_COUNTERS> counters;
+	std::array<std::atomic<uint64_t>, MAX_NEGOCIATION_STREAK + 1> negociation_streaks;
+
+	ThreadStats();
+	~ThreadStats();
+
+	void add_to(Stats &stats) const
+	{
+		for (uint8_t counter_i = 0; counter_i < NB_STATS_COUNTERS; ++counter_i)
+		{
+			stats.counters[counter_i] += this->counters[counter_i].load(std::memory_order_relaxed);
+		}
+		for (uint8_t length_i = 0; length_i <= MAX_NEGOCIATION_STREAK; ++length_i)
+		{
+			stats.negociation_streaks[length_i] += this->negociation_streaks[length_i].load(std::memory_order_relaxed);
+		}
+	}
+
+	void reset(void)
+	{
+		for (auto &counter : this->counters)
+		{
+			counter.store(0, std::memory_order_relaxed);
+		}
+		for (auto &counter : this->negociation_streaks)
+		{
+			counter.store(0, std::memory_order_relaxed);
+		}
+	}
+};
+
+// the counters of every live thread, and what the finished ones left behind
+struct StatsRegistry
+{
+	std::mutex mutex;
+	std::vector<ThreadStats*> thread_stats;
+	Stats finished_threads_stats{};
+};
+
+inline StatsRegistry &get_stats_registry(void)
+{
+	static StatsRegistry registry;
+	return registry;
+}
+
+inline ThreadStats::ThreadStats()
+{
+	this->reset();
+	auto &registry = get_stats_registry();
+	const std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.thread_stats.push_back(this);
+}
+
+inline ThreadStats::~ThreadStats()
+{
+	auto &registry = get_stats_registry();
+	const std::lock_guard<std::mutex> lock(registry.mutex);
+	this->add_to(registry.finished_threads_stats);
+	registry.thread_stats.erase(std::remove(registry.thread_stats.begin(), registry.thread_stats.end(), this), registry.thread_stats.end());
+}
+
+inline ThreadStats &get_thread_stats(void)
+{
+	static thread_local ThreadStats thread_stats;
+	return thread_stats;
+}
+
+// only the owning thread writes, so a load and a store are enough, without the lock prefix of fetch_add
+inline void increment_stat(std::atomic<uint64_t> &counter)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+inline void count_stat(const StatsCounter counter)
+{
+	increment_stat(get_thread_stats().counters[counter]);
+}
+
+inline void count_negociation_streak(const uint8_t length)
+{
+	increment_stat(get_thread_stats().negociation_streaks[(length < MAX_NEGOCIATION_STREAK) ? length : MAX_NEGOCIATION_STREAK]);
+}
+
+// sum over every thread, those still counting included
+inline Stats get_stats(void)
+{
+	Stats out{};
+	auto &registry = get_stats_registry();
+	const std::lock_guard<std::mutex> lock(registry.mutex);
+	out = registry.finished_threads_stats;
+	for (const auto thread_stats : registry.thread_stats)
+	{
+		thread_stats->add_to(out);
+	}
+	return out;
+}
+
+// meant for between runs, what threads count while it resets may or may not be kept
+inline void reset_stats(void)
+{
+	auto &registry = get_stats_registry();
+	const std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.finished_threads_stats = Stats{};
+	for (const auto thread_stats : registry.thread_stats)
+	{
+		thread_stats->reset();
+	}
+}
+
+} // Turncoat
+#endif // STATS_HXX
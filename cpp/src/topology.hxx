@@ -0,0 +1,145 @@
+#pragma once
+#ifndef TOPOLOGY_HXX
+#define TOPOLOGY_HXX
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+namespace Turncoat
+{
+
+/*
+ * board shape as bitmasks: bit j of neighbors[i] is set if hexagon i is adjacent to hexagon j,
+ * bit i of reachable is set if hexagon i can hold units
+ * the mask type is the smallest unsigned integer with one bit per hexagon, so copying a game state stays cheap
+ * everything is constexpr so that a map known at compile time (see constants/default_map.hxx) costs no setup at all
+ */
+template<uint8_t NB_HEXAGONS>
+struct BoardTopology
+{
+	static_assert(NB_HEXAGONS <= 64, "BoardTopology needs one bit per hexagon in a 64 bits mask");
+
+	using Mask = std::conditional_t<
+		(NB_HEXAGONS <= 16),
+		uint16_t,
+		std::conditional_t<(NB_HEXAGONS <= 32), uint32_t, uint64_t>
+	>;
+
+	static constexpr Mask ALL_HEXAGONS = (NB_HEXAGONS == 64) ? ~(Mask)0 : (Mask)(((uint64_t)1 << NB_HEXAGONS) - 1);
+
+	std::array<Mask, NB_HEXAGONS> neighbors;
+	Mask reachable;
+
+	static constexpr Mask to_mask(const uint8_t hexagon_idx)
+	{
+		return (Mask)((uint64_t)1 << hexagon_idx);
+	}
+
+	// every hexagon reachable and no edge, to be filled with add_edge and remove_hexagon
+	static constexpr BoardTopology empty(void)
+	{
+		BoardTopology out{{0}, ALL_HEXAGONS};
+		return out;
+	}
+
+	// edges are undirected, so both directions are set
+	constexpr void add_edge(const uint8_t first_hexagon_idx, const uint8_t second_hexagon_idx)
+	{
+		this->neighbors[first_hexagon_idx] |= to_mask(second_hexagon_idx);
+		this->neighbors[second_hexagon_idx] |= to_mask(first_hexagon_idx);
+	}
+
+	constexpr void remove_hexagon(const uint8_t hexagon_idx)
+	{
+		this->reachable &= ~to_mask(hexagon_idx);
+	}
+
+	template<size_t NB_EDGES>
+	static constexpr BoardTopology from_edges(
+		const std::array<std::pair<uint8_t, uint8_t>, NB_EDGES> &edges,
+		const Mask unreachable
+	)
+	{
+		auto out = empty();
+		for (const auto &edge : edges)
+		{
+			out.add_edge(edge.first, edge.second);
+		}
+		out.reachable &= ~unreachable;
+		return out;
+	}
+
+	// for maps only known at runtime, keeps the matrix as is, even if it is not symmetric
+	static BoardTopology from_adjacency_graph(
+		const std::array<std::array<bool, NB_HEXAGONS>, NB_HEXAGONS> &adjacency_graph,
+		const std::unordered_set<uint8_t> &unreachable_hexagons
+	)
+	{
+		auto out = empty();
+		for (uint8_t first_hexagon_i = 0; first_hexagon_i < NB_HEXAGONS; ++first_hexagon_i)
+		{
+			for (uint8_t second_hexagon_i = 0; second_hexagon_i < NB_HEXAGONS; ++second_hexagon_i)
+			{
+				if(adjacency_graph[first_hexagon_i][second_hexagon_i])
+				{
+					out.neighbors[first_hexagon_i] |= to_mask(second_hexagon_i);
+				}
+			}
+		}
+
+		for (const auto hexagon_idx : unreachable_hexagons)
+		{
+			if(hexagon_idx < NB_HEXAGONS)
+			{
+				out.remove_hexagon(hexagon_idx);
+			}
+		}
+		return out;
+	}
+
+	constexpr bool is_reachable(const uint8_t hexagon_idx) const
+	{
+		return (this->reachable >> hexagon_idx) & 1;
+	}
+
+	constexpr bool are_adjacent(const uint8_t first_hexagon_idx, const uint8_t second_hexagon_idx) const
+	{
+		return (this->neighbors[first_hexagon_idx] >> second_hexagon_idx) & 1;
+	}
+
+	// neighbors units can be rallied to
+	constexpr Mask get_reachable_neighbors(const uint8_t hexagon_idx) const
+	{
+		return this->neighbors[hexagon_idx] & this->reachable;
+	}
+
+	constexpr bool operator==(const BoardTopology &other) const
+	{
+		for (uint8_t hexagon_i = 0; hexagon_i < NB_HEXAGONS; ++hexagon_i)
+		{
+			if(this->neighbors[hexagon_i] != other.neighbors[hexagon_i])
+			{
+				return false;
+			}
+		}
+		return this->reachable == other.reachable;
+	}
+
+	constexpr bool operator!=(const BoardTopology &other) const
+	{
+		return !(*this == other);
+	}
+};
+
+// index of the lowest set bit of a non-zero mask
+template<typename Mask>
+inline uint8_t lowest_hexagon_idx(const Mask mask)
+{
+	return __builtin_ctzll(mask);
+}
+
+} // Turncoat
+#endif // TOPOLOGY_HXX
@@ -0,0 +1,156 @@
+#pragma once
+#ifndef TRANSPOSITION_TABLE_HXX
+#define TRANSPOSITION_TABLE_HXX
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace Turncoat
+{
+
+struct TranspositionStats
+{
+	float total_value;
+	uint32_t nb_visits;
+
+	inline float mean_value(void) const
+	{
+		return (this->nb_visits == 0) ? 0.f : this->total_value / this->nb_visits;
+	}
+};
+static_assert(sizeof(TranspositionStats) == sizeof(uint64_t));
+
+/*
+ * fixed-size hash map from a state hash (see GameState::get_hash) to value/visit statistics, shared between threads
+ *
+ * lock-free through the xor trick: every entry stores key ^ data next to data, a torn write from two threads
+ * racing on the same entry makes the pair inconsistent, which probe then sees as a miss instead of wrong stats
+ * concurrent updates of the same entry can lose one of the increments, which search code has to tolerate
+ *
+ * entries are grouped in buckets of one cache line, a key can only live in the bucket given by its low bits
+ * and evicts the least visited entry of that bucket when it is full
+ *
+ * not used by ISMCTS: its nodes are information sets reached through determinized states,
+ * which a hash of the full state does not identify, it is meant for searches on perfect information
+ */
+class TranspositionTable
+{
+public:
+	static constexpr uint8_t NB_ENTRIES_PER_BUCKET = 4;
+
+protected:
+	struct Entry
+	{
+		std::atomic<uint64_t> checked_key; // key ^ data
+		std::atomic<uint64_t> data;
+	};
+
+	struct alignas(64) Bucket
+	{
+		Entry entries[NB_ENTRIES_PER_BUCKET];
+	};
+	static_assert(sizeof(Bucket) == 64);
+
+	const uint64_t buckets_mask;
+	std::unique_ptr<Bucket[]> buckets;
+
+	static inline uint64_t to_data(const TranspositionStats stats)
+	{
+		uint64_t out;
+		::memcpy(&out, &stats, sizeof(out));
+		return out;
+	}
+
+	static inline TranspositionStats to_stats(const uint64_t data)
+	{
+		TranspositionStats out;
+		::memcpy(&out, &data, sizeof(out));
+		return out;
+	}
+
+	inline Bucket &get_bucket(const uint64_t key) const
+	{
+		return this->buckets[key & this->buckets_mask];
+	}
+
+public:
+	// holds 2^nb_buckets_log2 buckets, allocated once here
+	explicit TranspositionTable(const uint8_t nb_buckets_log2):
+	buckets_mask((1ULL << nb_buckets_log2) - 1),
+	buckets(std::make_unique<Bucket[]>(1ULL << nb_buckets_log2))
+	{}
+
+	inline uint64_t get_nb_entries(void) const
+	{
+		return (this->buckets_mask + 1) * NB_ENTRIES_PER_BUCKET;
+	}
+
+	// returns whether key was found, in which case its stats are written in out
+	bool probe(const uint64_t key, TranspositionStats &out) const
+	{
+		const Bucket &bucket = this->get_bucket(key);
+		for (const auto &entry : bucket.entries)
+		{
+			const uint64_t data = entry.data.load(std::memory_order_relaxed);
+			if((entry.checked_key.load(std::memory_order_relaxed) ^ data) == key)
+			{
+				out = to_stats(data);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// adds value and nb_visits to the stats of key, inserting it if needed
+	void update(const uint64_t key, const float value, const uint32_t nb_visits = 1)
+	{
+		Bucket &bucket = this->get_bucket(key);
+
+		Entry *replaced = &bucket.entries[0];
+		uint32_t replaced_nb_visits = UINT32_MAX;
+		TranspositionStats stats{0.f, 0};
+
+		for (auto &entry : bucket.entries)
+		{
+			const uint64_t data = entry.data.load(std::memory_order_relaxed);
+			const auto entry_stats = to_stats(data);
+			if((entry.checked_key.load(std::memory_order_relaxed) ^ data) == key)
+			{
+				replaced = &entry;
+				stats = entry_stats;
+				break;
+			}
+
+			if(entry_stats.nb_visits < replaced_nb_visits)
+			{
+				replaced = &entry;
+				replaced_nb_visits = entry_stats.nb_visits;
+			}
+		}
+
+		stats.total_value += value;
+		stats.nb_visits += nb_visits;
+
+		const uint64_t data = to_data(stats);
+		replaced->data.store(data, std::memory_order_relaxed);
+		replaced->checked_key.store(key ^ data, std::memory_order_relaxed);
+	}
+
+	// not thread safe
+	void clear(void)
+	{
+		for (uint64_t bucket_i = 0; bucket_i <= this->buckets_mask; ++bucket_i)
+		{
+			for (auto &entry : this->buckets[bucket_i].entries)
+			{
+				entry.data.store(0, std::memory_order_relaxed);
+				entry.checked_key.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+};
+
+} // Turncoat
+#endif // TRANSPOSITION_TABLE_HXX
@@ -0,0 +1,359 @@
+#pragma once
+#ifndef VECGAMEENV_HXX
+#define VECGAMEENV_HXX
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "./gamestate.hxx"
+#include "./move.hxx"
+#include "./observation.hxx"
+#include "./random.hxx"
+
+namespace Turncoat
+{
+
+/*
+ * nb_envs games stepped together, meant to be driven by a reinforcement learning loop
+ *
+ * every game is a GameState of its own, stepped in place, then copied into contiguous struct-of-arrays buffers
+ * (hexagons[nb_envs][NB_HEXAGONS][NB_FACTIONS], hands[nb_envs][NB_HANDS][NB_FACTIONS], ...) which bindings can expose without copying
+ *
+ * step writes the legal actions of every env as a list (legal_actions, nb_legal_actions), straight from generate_legal_moves
+ * the dense masks (NB_ACTIONS bytes per env) are only written by write_legal_action_masks, for the envs stepped or reset since
+ * its previous call: scattering a few hundred bytes per env costs about as much as stepping the game itself
+ *
+ * actions are MoveIds, followed by NB_FACTIONS discard actions: a NEGOCIATE action draws a unit in the player's hand,
+ * then the same player has to pick a DISCARD action before the turn moves on
+ *
+ * a finished game gets its rewards (1 for the winner, 0 for the others) and done flag, then is reset right away,
+ * its observation being the one of the next game. game k of env i is seeded from the i-th seed and k
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_HANDS,
+	uint8_t NB_INITIAL_PER_HAND,
+	uint8_t NB_STARTING_UNITS
+>
+class VecGameEnv
+{
+public:
+	using CorrespondingGameStateType = GameState<NB_HEXAGONS, NB_FACTIONS, NB_PER_FACTION, NB_HANDS, NB_INITIAL_PER_HAND, NB_STARTING_UNITS>;
+	using CorrespondingMoveCodec = typename CorrespondingGameStateType::CorrespondingMoveCodec;
+
+	static constexpr uint32_t DISCARD_OFFSET = CorrespondingGameStateType::NB_MOVES;
+	static constexpr uint32_t NB_ACTIONS = DISCARD_OFFSET + NB_FACTIONS;
+
+	// a list of legal actions holds either legal moves or discards
+	static constexpr uint32_t MAX_LEGAL_ACTIONS = CorrespondingGameStateType::MAX_LEGAL_MOVES;
+	static_assert(MAX_LEGAL_ACTIONS >= NB_FACTIONS, "no room for every discard action");
+	using ActionBuffer = typename CorrespondingGameStateType::MoveBuffer;
+
+	using CorrespondingObservationLayout = ObservationLayout<NB_HEXAGONS, NB_FACTIONS, NB_HANDS>;
+	static constexpr uint32_t OBS_SIZE = CorrespondingObservationLayout::SIZE;
+
+	const uint32_t nb_envs;
+
+	// per game state, struct of arrays
+	std::vector<uint8_t> hexagons; // [nb_envs][NB_HEXAGONS][NB_FACTIONS]
+	std::vector<uint8_t> hands; // [nb_envs][NB_HANDS][NB_FACTIONS]
+	std::vector<uint8_t> bag; // [nb_envs][NB_FACTIONS]
+	std::vector<uint8_t> attack_zone; // [nb_envs][NB_FACTIONS]
+	std::vector<uint8_t> rally_zone; // [nb_envs][NB_FACTIONS]
+	std::vector<uint8_t> successive_negociation_counter; // [nb_envs]
+	std::vector<uint8_t> current_player_idx; // [nb_envs]
+	std::vector<uint8_t> pending_discard; // [nb_envs]
+
+	std::vector<uint64_t> seeds; // [nb_envs]
+	std::vector<uint64_t> nb_finished_games; // [nb_envs]
+
+	// step outputs
+	std::vector<uint8_t> observations; // [nb_envs][OBS_SIZE]
+	std::vector<ActionBuffer> legal_actions; // [nb_envs][MAX_LEGAL_ACTIONS], only the first nb_legal_actions[i] of env i are set
+	std::vector<MoveId> nb_legal_actions; // [nb_envs]
+	std::vector<uint8_t> legal_action_masks; // [nb_envs][NB_ACTIONS], see write_legal_action_masks
+	std::vector<float> rewards; // [nb_envs][NB_HANDS]
+	std::vector<uint8_t> dones; // [nb_envs]
+
+protected:
+	const typename CorrespondingGameStateType::CorrespondingBoardTopology topology;
+	const std::array<uint8_t, NB_FACTIONS> factions_starting_point;
+
+	std::vector<CorrespondingGameStateType> game_states; // [nb_envs]
+
+	// what is set in legal_action_masks, cleared when the mask of the env is written again
+	std::vector<ActionBuffer> masked_actions; // [nb_envs]
+	std::vector<MoveId> nb_masked_actions; // [nb_envs]
+	std::vector<uint8_t> is_mask_stale; // [nb_envs]
+
+	inline uint64_t get_game_seed(const uint32_t env_idx) const
+	{
+		return SplitMix64{this->seeds[env_idx]}.split(this->nb_finished_games[env_idx]).state;
+	}
+
+	void store_game_state(const uint32_t env_idx)
+	{
+		const auto &game_state = this->game_states[env_idx];
+
+		::memcpy(&this->hexagons[(size_t)env_idx * NB_HEXAGONS * NB_FACTIONS], &game_state.get_hexagons(), NB_HEXAGONS * NB_FACTIONS);
+		::memcpy(&this->hands[(size_t)env_idx * NB_HANDS * NB_FACTIONS], &game_state.get_hands(), NB_HANDS * NB_FACTIONS);
+		::memcpy(&this->bag[(size_t)env_idx * NB_FACTIONS], &game_state.get_bag(), NB_FACTIONS);
+		::memcpy(&this->attack_zone[(size_t)env_idx * NB_FACTIONS], &game_state.get_attack_zone(), NB_FACTIONS);
+		::memcpy(&this->rally_zone[(size_t)env_idx * NB_FACTIONS], &game_state.get_rally_zone(), NB_FACTIONS);
+		this->successive_negociation_counter[env_idx] = game_state.get_successive_negociation_counter();
+	}
+
+	void new_game(const uint32_t env_idx)
+	{
+		this->game_states[env_idx] = CorrespondingGameStateType(
+			this->topology,
+			&this->factions_starting_point,
+			this->get_game_seed(env_idx)
+		);
+		this->store_game_state(env_idx);
+
+		this->current_player_idx[env_idx] = 0;
+		this->pending_discard[env_idx] = false;
+	}
+
+	// writes observation and legal actions of env_idx from its buffers and its game, its mask is written later on
+	void observe(const uint32_t env_idx)
+	{
+		const uint8_t player_idx = this->current_player_idx[env_idx];
+		const uint8_t *hand = &this->hands[((size_t)env_idx * NB_HANDS + player_idx) * NB_FACTIONS];
+		uint8_t *observation = &this->observations[(size_t)env_idx * OBS_SIZE];
+
+		::memcpy(observation + CorrespondingObservationLayout::HEXAGONS_OFFSET, &this->hexagons[(size_t)env_idx * NB_HEXAGONS * NB_FACTIONS], NB_HEXAGONS * NB_FACTIONS);
+		::memcpy(observation + CorrespondingObservationLayout::HAND_OFFSET, hand, NB_FACTIONS);
+		::memcpy(observation + CorrespondingObservationLayout::ATTACK_ZONE_OFFSET, &this->attack_zone[(size_t)env_idx * NB_FACTIONS], NB_FACTIONS);
+		::memcpy(observation + CorrespondingObservationLayout::RALLY_ZONE_OFFSET, &this->rally_zone[(size_t)env_idx * NB_FACTIONS], NB_FACTIONS);
+		for (uint8_t hand_i = 0; hand_i < NB_HANDS; ++hand_i)
+		{
+			uint8_t hand_size = 0;
+			for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
+			{
+				hand_size += this->hands[((size_t)env_idx * NB_HANDS + hand_i) * NB_FACTIONS + faction_i];
+			}
+			observation[CorrespondingObservationLayout::HAND_SIZES_OFFSET + hand_i] = hand_size;
+		}
+		observation[CorrespondingObservationLayout::PLAYER_OFFSET] = player_idx;
+		observation[CorrespondingObservationLayout::NEGOCIATION_COUNTER_OFFSET] = this->successive_negociation_counter[env_idx];
+		observation[CorrespondingObservationLayout::PENDING_DISCARD_OFFSET] = this->pending_discard[env_idx];
+
+		auto &legal_actions = this->legal_actions[env_idx];
+		if(this->pending_discard[env_idx])
+		{
+			MoveId nb_legal_actions = 0;
+			for (uint8_t faction_i = 0; faction_i < NB_FACTIONS; ++faction_i)
+			{
+				legal_actions[nb_legal_actions] = DISCARD_OFFSET + faction_i;
+				nb_legal_actions += hand[faction_i] > 0;
+			}
+			this->nb_legal_actions[env_idx] = nb_legal_actions;
+		}
+		else
+		{
+			this->nb_legal_actions[env_idx] = this->game_states[env_idx].generate_legal_moves(player_idx, legal_actions);
+		}
+		this->is_mask_stale[env_idx] = true;
+	}
+
+	// returns whether action was legal, illegal actions leave the game untouched
+	bool act(const uint32_t env_idx, const uint32_t action)
+	{
+		const uint8_t player_idx = this->current_player_idx[env_idx];
+		auto &game_state = this->game_states[env_idx];
+
+		// checked against the game rather than the mask, which may not have been written since the previous step
+		if(this->pending_discard[env_idx])
+		{
+			if(action < DISCARD_OFFSET || action >= NB_ACTIONS || !game_state.discard_for_negociation(player_idx, action - DISCARD_OFFSET))
+			{
+				return false;
+			}
+			this->pending_discard[env_idx] = false;
+		}
+		else if(action >= DISCARD_OFFSET || !game_state.is_legal(player_idx, action))
+		{
+			return false;
+		}
+		else if(CorrespondingMoveCodec::get_order_type(action) == NEGOCIATE)
+		{
+			game_state.draw_for_negociation(player_idx);
+			this->pending_discard[env_idx] = true;
+			return true;
+		}
+		else
+		{
+			// the discarded faction picker is never called for these
+			game_state.make_move(player_idx, action, [](const std::array<uint8_t, NB_FACTIONS>&){return NB_FACTIONS;});
+		}
+
+		++(this->current_player_idx[env_idx]);
+		this->current_player_idx[env_idx] *= (this->current_player_idx[env_idx] < NB_HANDS);
+
+		return true;
+	}
+
+public:
+	VecGameEnv(
+		const uint32_t nb_envs,
+		const std::vector<uint64_t> &seeds,
+		const std::array<std::array<bool, NB_HEXAGONS>, NB_HEXAGONS> &adjacency_graph,
+		const std::array<uint8_t, NB_FACTIONS> &factions_starting_point,
+		const std::unordered_set<uint8_t> &unreachable_hexagons
+	):
+	nb_envs(nb_envs),
+	hexagons((size_t)nb_envs * NB_HEXAGONS * NB_FACTIONS),
+	hands((size_t)nb_envs * NB_HANDS * NB_FACTIONS),
+	bag((size_t)nb_envs * NB_FACTIONS),
+	attack_zone((size_t)nb_envs * NB_FACTIONS),
+	rally_zone((size_t)nb_envs * NB_FACTIONS),
+	successive_negociation_counter(nb_envs),
+	current_player_idx(nb_envs),
+	pending_discard(nb_envs),
+	seeds(seeds),
+	nb_finished_games(nb_envs, 0),
+	observations((size_t)nb_envs * OBS_SIZE),
+	legal_actions(nb_envs),
+	nb_legal_actions(nb_envs, 0),
+	legal_action_masks((size_t)nb_envs * NB_ACTIONS),
+	rewards((size_t)nb_envs * NB_HANDS),
+	dones(nb_envs),
+	topology(CorrespondingGameStateType::CorrespondingBoardTopology::from_adjacency_graph(adjacency_graph, unreachable_hexagons)),
+	factions_starting_point(factions_starting_point),
+	masked_actions(nb_envs),
+	nb_masked_actions(nb_envs, 0),
+	is_mask_stale(nb_envs, true)
+	{
+		if(seeds.size() != nb_envs)
+		{
+			throw std::invalid_argument("[VecGameEnv]\tExpected one seed per env");
+		}
+
+		this->game_states.reserve(nb_envs);
+		for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+		{
+			this->game_states.emplace_back(this->topology, &this->factions_starting_point, this->get_game_seed(env_i));
+		}
+		this->reset();
+	}
+
+	void reset(void)
+	{
+		for (uint32_t env_i = 0; env_i < this->nb_envs; ++env_i)
+		{
+			this->new_game(env_i);
+			this->observe(env_i);
+		}
+		std::fill(this->rewards.begin(), this->rewards.end(), 0.f);
+		std::fill(this->dones.begin(), this->dones.end(), 0);
+	}
+
+	/*
+	 * plays actions[i] in env i, for every env. an illegal action (see legal_action_masks) is ignored and the same player has to play again
+	 * returns the number of illegal actions
+	 */
+	uint32_t step(const uint32_t *actions)
+	{
+		uint32_t nb_illegal_actions = 0;
+
+		// an env whose action was illegal did not change, its buffers and legal actions are left as they are
+		// a finished game is only observed once reset, below
+		for (uint32_t env_i = 0; env_i < this->nb_envs; ++env_i)
+		{
+			if(!this->act(env_i, actions[env_i]))
+			{
+				++nb_illegal_actions;
+				continue;
+			}
+
+			this->store_game_state(env_i);
+			if(this->successive_negociation_counter[env_i] != NB_HANDS)
+			{
+				this->observe(env_i);
+			}
+		}
+
+		// branchless over the whole batch, so that it gets vectorized. locals keep the uint8_t stores from aliasing this->nb_envs
+		const uint32_t nb_envs = this->nb_envs;
+		const uint8_t *counters = this->successive_negociation_counter.data();
+		uint8_t *dones = this->dones.data();
+		for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+		{
+			dones[env_i] = counters[env_i] == NB_HANDS;
+		}
+
+		float *rewards = this->rewards.data();
+		for (size_t reward_i = 0; reward_i < this->rewards.size(); ++reward_i)
+		{
+			rewards[reward_i] = 0.f;
+		}
+
+		for (uint32_t env_i = 0; env_i < this->nb_envs; ++env_i)
+		{
+			if(!dones[env_i])
+			{
+				continue;
+			}
+
+			rewards[env_i * NB_HANDS + this->game_states[env_i].get_winning_hand()] = 1.f;
+
+			++(this->nb_finished_games[env_i]);
+			this->new_game(env_i);
+			this->observe(env_i);
+		}
+
+		return nb_illegal_actions;
+	}
+
+	/*
+	 * brings legal_action_masks in line with legal_actions, for the envs stepped or reset since the previous call only
+	 * returns the number of masks written
+	 */
+	uint32_t write_legal_action_masks(void)
+	{
+		uint32_t nb_written_masks = 0;
+
+		for (uint32_t env_i = 0; env_i < this->nb_envs; ++env_i)
+		{
+			if(!this->is_mask_stale[env_i])
+			{
+				continue;
+			}
+
+			// locals, since the uint8_t stores to the mask could alias anything reached through this
+			uint8_t *legal_action_mask = &this->legal_action_masks[(size_t)env_i * NB_ACTIONS];
+			auto &masked_actions = this->masked_actions[env_i];
+			const auto &legal_actions = this->legal_actions[env_i];
+			const MoveId nb_masked_actions = this->nb_masked_actions[env_i];
+			const MoveId nb_legal_actions = this->nb_legal_actions[env_i];
+
+			for (MoveId action_i = 0; action_i < nb_masked_actions; ++action_i)
+			{
+				legal_action_mask[masked_actions[action_i]] = 0;
+			}
+			for (MoveId action_i = 0; action_i < nb_legal_actions; ++action_i)
+			{
+				legal_action_mask[legal_actions[action_i]] = 1;
+			}
+
+			std::copy_n(legal_actions.begin(), nb_legal_actions, masked_actions.begin());
+			this->nb_masked_actions[env_i] = nb_legal_actions;
+			this->is_mask_stale[env_i] = false;
+			++nb_written_masks;
+		}
+
+		return nb_written_masks;
+	}
+};
+
+} // Turncoat
+#endif // VECGAMEENV_HXX
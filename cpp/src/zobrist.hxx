@@ -0,0 +1,86 @@
+#pragma once
+#ifndef ZOBRIST_HXX
+#define ZOBRIST_HXX
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "./random.hxx"
+
+namespace Turncoat
+{
+
+/*
+ * one 64 bits key per (location, faction, count), locations being hexagons, hands, bag, attack zone and rally zone,
+ * plus one key per value of the negociation counter up to NB_HANDS
+ * counts go from 0 to NB_PER_FACTION since no location can ever hold more than a whole faction
+ * keys are generated at compile time so that every build hashes states the same way
+ */
+template<
+	uint8_t NB_HEXAGONS,
+	uint8_t NB_FACTIONS,
+	uint8_t NB_PER_FACTION,
+	uint8_t NB_HANDS
+>
+struct ZobristKeys
+{
+	static constexpr size_t NB_COUNTS = (size_t)NB_PER_FACTION + 1;
+
+	static constexpr size_t HEXAGONS_OFFSET = 0;
+	static constexpr size_t HANDS_OFFSET = HEXAGONS_OFFSET + (size_t)NB_HEXAGONS * NB_FACTIONS * NB_COUNTS;
+	static constexpr size_t BAG_OFFSET = HANDS_OFFSET + (size_t)NB_HANDS * NB_FACTIONS * NB_COUNTS;
+	static constexpr size_t ATTACK_ZONE_OFFSET = BAG_OFFSET + (size_t)NB_FACTIONS * NB_COUNTS;
+	static constexpr size_t RALLY_ZONE_OFFSET = ATTACK_ZONE_OFFSET + (size_t)NB_FACTIONS * NB_COUNTS;
+	static constexpr size_t NEGOCIATION_COUNTER_OFFSET = RALLY_ZONE_OFFSET + (size_t)NB_FACTIONS * NB_COUNTS;
+	static constexpr size_t NB_KEYS = NEGOCIATION_COUNTER_OFFSET + (size_t)NB_HANDS + 1;
+
+	static constexpr std::array<uint64_t, NB_KEYS> generate_keys(void)
+	{
+		std::array<uint64_t, NB_KEYS> out = {0};
+		SplitMix64 random_generator{0x7475726E636F6174ULL}; // "turncoat"
+		for (auto &key : out)
+		{
+			key = random_generator();
+		}
+		return out;
+	}
+
+	static constexpr std::array<uint64_t, NB_KEYS> keys = generate_keys();
+
+	// each of the following returns the NB_COUNTS keys of a (location, faction), to be indexed by count
+
+	static constexpr const uint64_t *hexagon(const uint8_t hexagon_idx, const uint8_t faction_idx)
+	{
+		return &keys[HEXAGONS_OFFSET + ((size_t)hexagon_idx * NB_FACTIONS + faction_idx) * NB_COUNTS];
+	}
+
+	static constexpr const uint64_t *hand(const uint8_t hand_idx, const uint8_t faction_idx)
+	{
+		return &keys[HANDS_OFFSET + ((size_t)hand_idx * NB_FACTIONS + faction_idx) * NB_COUNTS];
+	}
+
+	static constexpr const uint64_t *bag(const uint8_t faction_idx)
+	{
+		return &keys[BAG_OFFSET + (size_t)faction_idx * NB_COUNTS];
+	}
+
+	static constexpr const uint64_t *attack_zone(const uint8_t faction_idx)
+	{
+		return &keys[ATTACK_ZONE_OFFSET + (size_t)faction_idx * NB_COUNTS];
+	}
+
+	static constexpr const uint64_t *rally_zone(const uint8_t faction_idx)
+	{
+		return &keys[RALLY_ZONE_OFFSET + (size_t)faction_idx * NB_COUNTS];
+	}
+
+	// the counter can go past NB_HANDS when a hand negociates several times in a row, which all mean the game is over
+	static constexpr uint64_t negociation_counter(const uint8_t successive_negociation_counter)
+	{
+		return keys[NEGOCIATION_COUNTER_OFFSET + std::min(successive_negociation_counter, NB_HANDS)];
+	}
+};
+
+} // Turncoat
+#endif // ZOBRIST_HXX
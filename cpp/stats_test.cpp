@@ -0,0 +1,16 @@
+// the counters are off in main_test.cpp, this translation unit checks what they count
+#ifndef TURNCOAT_STATS
+#define TURNCOAT_STATS
+#endif // TURNCOAT_STATS
+
+#include "test/stats_test.hxx"
+
+/*
+	c++ -O2 -std=c++17 -pthread stats_test.cpp -o stats_test
+*/
+
+int main(void)
+{
+	test_stats();
+	return 0;
+}
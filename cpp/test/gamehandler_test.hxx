@@ -17,7 +17,7 @@ using DefaultGameHandlerType = GameHandler<
   	default_nb_per_hand,
   	default_nb_starting_units
   >;
-using DefaultGameViewType = GameView<default_nb_hexagons, default_nb_factions>;
+using DefaultGameViewType = GameView<default_nb_hexagons, default_nb_factions, default_nb_hands>;
 using DefaultOrderType = Order<default_nb_hexagons, default_nb_factions, default_nb_per_faction>;
 
 const uint16_t MAX_ALLOWED_GAME_SIZE = sizeof(std::mt19937) + 1024;
@@ -34,7 +34,7 @@ const uint16_t MAX_ALLOWED_GAMEHANDLER_SIZE = 512;
 																																																		\
 	const std::function< 																																							\
 		Order<default_nb_hexagons, default_nb_factions, default_nb_per_faction>(												\
-			const GameView<default_nb_hexagons, default_nb_factions>																			\
+			const GameView<default_nb_hexagons, default_nb_factions, default_nb_hands>																			\
 		)																																																\
 	> always_order_negociate = [](const DefaultGameViewType dgvt){return DefaultOrderType();};				\
 																																																		\
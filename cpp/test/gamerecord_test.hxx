@@ -0,0 +1,337 @@
+#pragma once
+#ifndef GAMERECORD_TEST_HXX
+#define GAMERECORD_TEST_HXX
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test.hxx"
+#include "gamestate_test.hxx"
+#include "staticgamehandler_test.hxx"
+#include "../src/gamerecord.hxx"
+#include "../src/staticgamehandler.hxx"
+
+using namespace Turncoat;
+
+using DefaultGameRecordWriterType = GameRecordWriter<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units
+  >;
+
+using DefaultGameRecordReaderType = GameRecordReader<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units
+  >;
+
+using DefaultGameRecordFormat = DefaultGameRecordWriterType::CorrespondingFormat;
+
+// random legal orders, but every other discard is impossible so that failed negociations get recorded too
+struct ClumsyPolicy
+{
+	RandomLegalPolicy random_legal_policy;
+	uint8_t nb_picks;
+
+	DefaultOrderType get_order(const DefaultGameStateViewType &game_state_view)
+	{
+		return this->random_legal_policy.get_order(game_state_view);
+	}
+
+	uint8_t pick_discarded_faction(const std::array<uint8_t, default_nb_factions> &hand)
+	{
+		++(this->nb_picks);
+		return (this->nb_picks % 2 == 1) ? default_nb_factions : discard_first_in_hand(hand);
+	}
+};
+
+using ClumsyStaticGameHandlerType = UniformStaticGameHandler<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units,
+  	ClumsyPolicy
+  >;
+
+const std::string game_record_test_path = "/tmp/turncoat_gamerecord_test.bin";
+
+struct RecordedGame
+{
+	std::vector<uint64_t> hashes; // before every step, then at the end
+	uint8_t winner;
+};
+
+std::vector<RecordedGame> record_games(const uint64_t nb_games, const bool with_observations)
+{
+	std::vector<RecordedGame> out;
+	DefaultGameRecordWriterType writer(
+		game_record_test_path,
+		default_board_topology,
+		default_factions_starting_point,
+		with_observations,
+		256 // small, so that games straddle flushes
+	);
+
+	for (uint64_t seed = 0; seed < nb_games; ++seed)
+	{
+		auto handler = ClumsyStaticGameHandlerType(
+			default_board_topology,
+			&default_factions_starting_point,
+			seed,
+			{
+				ClumsyPolicy{RandomLegalPolicy{SplitMix64{seed}.split(0)}, 0},
+				ClumsyPolicy{RandomLegalPolicy{SplitMix64{seed}.split(1)}, 0},
+				ClumsyPolicy{RandomLegalPolicy{SplitMix64{seed}.split(2)}, 0},
+				ClumsyPolicy{RandomLegalPolicy{SplitMix64{seed}.split(3)}, 0}
+			}
+		);
+		handler.start_recording(writer);
+
+		RecordedGame recorded_game;
+		recorded_game.hashes.push_back(handler.get_game_state().get_hash());
+		while(handler.get_game_state().get_successive_negociation_counter() < default_nb_hands)
+		{
+			const auto nb_steps = writer.game_nb_steps;
+			handler.run_turn();
+			if(writer.game_nb_steps != nb_steps)
+			{
+				recorded_game.hashes.push_back(handler.get_game_state().get_hash());
+			}
+		}
+		recorded_game.winner = handler.get_winner();
+		assert(!writer.is_in_game);
+		out.push_back(recorded_game);
+	}
+	assert(writer.get_nb_games() == nb_games);
+	return out;
+}
+
+void test_varint_round_trip(void)
+{
+	const std::vector<uint64_t> values = {0, 1, 127, 128, 300, 16383, 16384, UINT32_MAX, UINT64_MAX};
+	for (const auto value : values)
+	{
+		std::array<uint8_t, 10> buffer;
+		const uint8_t *end = write_varint(value, buffer.data());
+		assert(end - buffer.data() == (value == 0 ? 1 : (64 - __builtin_clzll(value) + 6) / 7));
+
+		uint64_t read_value;
+		assert(read_varint(buffer.data(), end, read_value) == end);
+		assert(read_value == value);
+
+		assert(read_varint(buffer.data(), end - 1, read_value) == nullptr);
+	}
+}
+
+// replaying the first k steps gives back the state the game was in before its k-th step
+void test_gamerecord_replay(void)
+{
+	const uint64_t nb_games = 20;
+	const auto recorded_games = record_games(nb_games, true);
+
+	const DefaultGameRecordReaderType reader(game_record_test_path);
+	assert(reader.get_nb_games() == nb_games);
+	assert(reader.has_observations());
+	assert(reader.get_topology() == default_board_topology);
+	assert(reader.get_factions_starting_point() == default_factions_starting_point);
+
+	bool has_failed_negociation = false;
+	for (uint64_t game_i = 0; game_i < nb_games; ++game_i)
+	{
+		const auto &recorded_game = recorded_games[game_i];
+		const auto steps = reader.get_steps(game_i);
+		assert(reader.get_seed(game_i) == game_i);
+		assert(reader.get_nb_steps(game_i) == steps.size());
+		assert(steps.size() + 1 == recorded_game.hashes.size());
+
+		const uint8_t *observations = reader.get_observations(game_i);
+		for (uint32_t step_i = 0; step_i <= steps.size(); ++step_i)
+		{
+			const auto game_state = reader.replay(game_i, step_i);
+			assert(game_state.get_hash() == recorded_game.hashes[step_i]);
+			assert_units_are_conserved(game_state);
+
+			if(step_i == steps.size())
+			{
+				break;
+			}
+
+			has_failed_negociation |= (steps[step_i].discarded_faction_idx == default_nb_factions);
+
+			std::array<uint8_t, DefaultGameRecordFormat::OBS_SIZE> observation;
+			DefaultGameRecordFormat::write_observation(
+				DefaultGameStateViewType(game_state, steps[step_i].hand_idx),
+				observation.data()
+			);
+			assert(std::equal(
+				observation.begin(),
+				observation.end(),
+				observations + step_i * DefaultGameRecordFormat::OBS_SIZE
+			));
+		}
+
+		auto final_game_state = reader.replay(game_i);
+		assert(final_game_state.get_successive_negociation_counter() == default_nb_hands);
+		assert(final_game_state.get_winning_hand() == recorded_game.winner);
+	}
+	assert(has_failed_negociation);
+
+	std::remove(game_record_test_path.c_str());
+}
+
+void test_gamerecord_without_observations(void)
+{
+	const uint64_t nb_games = 5;
+	const auto recorded_games = record_games(nb_games, false);
+
+	const DefaultGameRecordReaderType reader(game_record_test_path);
+	assert(reader.get_nb_games() == nb_games);
+	assert(!reader.has_observations());
+	for (uint64_t game_i = 0; game_i < nb_games; ++game_i)
+	{
+		assert(reader.get_observations(game_i) == nullptr);
+		assert(reader.replay(game_i).get_hash() == recorded_games[game_i].hashes.back());
+	}
+
+	std::remove(game_record_test_path.c_str());
+}
+
+template<typename Exception, typename F>
+bool does_throw(F &&fn)
+{
+	try
+	{
+		fn();
+	}
+	catch(const Exception &)
+	{
+		return true;
+	}
+	return false;
+}
+
+// errors are thrown rather than ending the process, which would take the python interpreter with it
+void test_gamerecord_reader_errors(void)
+{
+	const uint64_t nb_games = 3;
+	record_games(nb_games, false);
+
+	{
+		const DefaultGameRecordReaderType reader(game_record_test_path);
+		assert(does_throw<std::out_of_range>([&reader](){reader.get_steps(nb_games);}));
+		assert(does_throw<std::out_of_range>([&reader](){reader.replay(nb_games);}));
+	}
+
+	// a game count which only fits in the file once multiplied by the size of an offset, modulo 2^64
+	{
+		FILE *file = ::fopen(game_record_test_path.c_str(), "r+b");
+		const uint64_t nb_wrapping_games = (1ULL << 61) + 1;
+		assert(::fseek(file, -(long)DefaultGameRecordFormat::FOOTER_TAIL_SIZE, SEEK_END) == 0);
+		assert(::fwrite(&nb_wrapping_games, sizeof(nb_wrapping_games), 1, file) == 1);
+		assert(::fclose(file) == 0);
+		assert(does_throw<std::runtime_error>([](){DefaultGameRecordReaderType reader(game_record_test_path);}));
+	}
+
+	// a game offset which only fits in the file once added to the size of what is read, modulo 2^64
+	record_games(nb_games, false);
+	{
+		FILE *file = ::fopen(game_record_test_path.c_str(), "r+b");
+		const uint64_t wrapping_game_offset = UINT64_MAX - 3;
+		assert(::fseek(file, -(long)(DefaultGameRecordFormat::FOOTER_TAIL_SIZE + nb_games * sizeof(uint64_t)), SEEK_END) == 0);
+		assert(::fwrite(&wrapping_game_offset, sizeof(wrapping_game_offset), 1, file) == 1);
+		assert(::fclose(file) == 0);
+
+		const DefaultGameRecordReaderType reader(game_record_test_path);
+		assert(does_throw<std::runtime_error>([&reader](){reader.get_seed(0);}));
+		assert(does_throw<std::runtime_error>([&reader](){reader.get_steps(0);}));
+		assert(does_throw<std::runtime_error>([&reader](){reader.replay(0);}));
+		assert(reader.get_steps(1).size() == reader.get_nb_steps(1));
+	}
+
+	// without its footer, as if the writer had not been closed
+	struct stat file_stat;
+	assert(::stat(game_record_test_path.c_str(), &file_stat) == 0);
+	assert(::truncate(game_record_test_path.c_str(), file_stat.st_size - 1) == 0);
+	assert(does_throw<std::runtime_error>([](){DefaultGameRecordReaderType reader(game_record_test_path);}));
+
+	std::remove(game_record_test_path.c_str());
+	assert(does_throw<std::runtime_error>([](){DefaultGameRecordReaderType reader(game_record_test_path);}));
+}
+
+// records a single game made of the given steps, which the writer does not check
+void record_steps(const uint64_t seed, const std::vector<std::pair<MoveId, uint8_t>> &steps)
+{
+	DefaultGameRecordWriterType writer(game_record_test_path, default_board_topology, default_factions_starting_point, false);
+	writer.begin_game(seed);
+	for (const auto &[move, discarded_faction_idx] : steps)
+	{
+		writer.add_step(move, discarded_faction_idx, nullptr);
+	}
+	writer.end_game();
+	writer.close();
+}
+
+// a tampered record is rejected by replay rather than played, make_move would underflow unit counts
+void test_gamerecord_replay_rejects_illegal_steps(void)
+{
+	using CorrespondingMoveCodec = DefaultGameStateType::CorrespondingMoveCodec;
+
+	// more units than there are on the board
+	record_steps(0, {{CorrespondingMoveCodec::encode_attack(0, 1, default_nb_per_faction - 1, 0), 0}});
+	{
+		const DefaultGameRecordReaderType reader(game_record_test_path);
+		assert(reader.get_steps(0).size() == 1);
+		assert(reader.replay(0, 0).get_hash() == DefaultGameStateType(default_board_topology, &default_factions_starting_point, 0).get_hash());
+		assert(does_throw<std::runtime_error>([&reader](){reader.replay(0);}));
+	}
+
+	// discarding a faction absent from the hand, even once the drawn unit is in it
+	for (uint64_t seed = 0;; ++seed)
+	{
+		auto game_state = DefaultGameStateType(default_board_topology, &default_factions_starting_point, seed);
+		game_state.draw_for_negociation(0);
+		const auto &hand = game_state.get_hands()[0];
+		const auto absent_faction = std::find(hand.begin(), hand.end(), 0);
+		if(absent_faction == hand.end())
+		{
+			continue;
+		}
+
+		record_steps(seed, {{CorrespondingMoveCodec::encode_negociate(), (uint8_t)(absent_faction - hand.begin())}});
+		const DefaultGameRecordReaderType reader(game_record_test_path);
+		assert(does_throw<std::runtime_error>([&reader](){reader.replay(0);}));
+		break;
+	}
+
+	// while a failed negociation is a legal step
+	record_steps(0, {{CorrespondingMoveCodec::encode_negociate(), default_nb_factions}});
+	{
+		const DefaultGameRecordReaderType reader(game_record_test_path);
+		assert(reader.replay(0).get_hash() == DefaultGameStateType(default_board_topology, &default_factions_starting_point, 0).get_hash());
+	}
+
+	std::remove(game_record_test_path.c_str());
+}
+
+void test_gamerecord(void)
+{
+	test_varint_round_trip();
+	test_gamerecord_replay();
+	test_gamerecord_without_observations();
+	test_gamerecord_reader_errors();
+	test_gamerecord_replay_rejects_illegal_steps();
+}
+
+#endif // GAMERECORD_TEST_HXX
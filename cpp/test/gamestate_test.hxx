@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <numeric>
 #include <cstring>
+#include <vector>
 
 #include "test.hxx"
 #include "../src/gamestate.hxx"
@@ -24,6 +25,8 @@ using DefaultGameStateType = GameState<
   	default_nb_starting_units
   >;
 
+const uint16_t MAX_ALLOWED_SNAPSHOT_SIZE = 128;
+const uint16_t MAX_ALLOWED_UNDO_RECORD_SIZE = 40;
 
 #ifndef INITIALIZE_DEFAULT_GAMESTATE
 #define INITIALIZE_DEFAULT_GAMESTATE(ConstToken, VarName, Seed)								\
@@ -45,8 +48,7 @@ const std::array<uint8_t, default_nb_factions> factions_starting_point = {{2, 6,
 #endif //INITIALIZE_DEFAULT_GAMESTATE
 
 /*
- * this is enough because rn there is no mutable pointer in GameState apart from the random generator
- * and i don't care about it changing for now
+ * this is enough because rn there is no mutable pointer in GameState, the random generator being held by value
  * however remember to change this if you add mutable pointers in gamestate (which kinda goes against the spirit, but eh)
 */
 bool is_unchanged_after_call(void *obj, const size_t obj_size, std::function<void(void *)> call)
@@ -69,9 +71,7 @@ void test_gamestate_constructor(void)
 
 	// sanity checks
 	assert(tested.successive_negociation_counter == 0);
-	assert(tested.adjacency_graph == &adjacency_graph);
-	assert(tested.random_generator == &random_generator);
-	assert(tested.unreachable_hexagons == &unreachable_hexagons);
+	assert(tested.topology == DefaultGameStateType::CorrespondingBoardTopology::from_adjacency_graph(adjacency_graph, unreachable_hexagons));
 	assert(tested.attack_zone.size() == default_nb_factions);
 	assert(tested.rally_zone.size() == default_nb_factions);
 
@@ -162,6 +162,7 @@ void test_negociate(void)
 	tested.hands[0][0] = default_nb_per_hand;
 	tested.hands[0][1] = 0;
 	tested.hands[0][2] = 0;
+	tested.recompute_hash();
 
 	auto pick_first_faction = [](const std::array<uint8_t, default_nb_factions>&){return 0;};
 
@@ -192,6 +193,7 @@ void test_deploy(void)
 	tested.hexagons[hexagon_idx][2] = 0;
 
 	tested.successive_negociation_counter = 1;
+	tested.recompute_hash();
 
 	// success case
 	assert(tested.deploy(hand_idx, faction_idx, hexagon_idx));
@@ -233,6 +235,7 @@ void test_rally(void)
 	tested.hexagons[end_hexagon_idx][faction_idx] = 0;
 
 	tested.successive_negociation_counter = 1;
+	tested.recompute_hash();
 
 	auto assert_no_faction_in_hand_returns_false = (
 		[hand_idx, wrong_faction_idx, nb_units, start_hexagon_idx, end_hexagon_idx]
@@ -317,6 +320,7 @@ void test_attack(void)
 	tested.bag[atked_faction_idx] = 0;
 	
 	tested.successive_negociation_counter = 1;
+	tested.recompute_hash();
 
 	auto assert_invalid_hex_returns_false = (
 		[hand_idx, atking_faction_idx, atked_faction_idx, nb_atked_units, invalid_hexagon_idx]
@@ -528,7 +532,7 @@ void test_get_winning_by_random_hand(void)
 	const auto seed = 0x84D8483;
 	INITIALIZE_DEFAULT_GAMESTATE(, tested, seed)
 
-	const auto expected_winning_hand = 1;
+	const auto expected_winning_hand = 2;
 
 	for (auto faction_i = 0; faction_i < default_nb_factions; ++faction_i)
 	{
@@ -560,6 +564,345 @@ void test_get_winning_hand(void)
 	test_get_winning_by_random_hand();
 }
 
+uint8_t discard_first_in_hand(const std::array<uint8_t, default_nb_factions>& hand)
+{
+	for (uint8_t faction_i = 0; faction_i < hand.size(); ++faction_i)
+	{
+		if(hand[faction_i] > 0)
+		{
+			return faction_i;
+		}
+	}
+	return (uint8_t)hand.size();
+}
+
+void assert_units_are_conserved(const DefaultGameStateType &tested)
+{
+	for (auto faction_i = 0; faction_i < default_nb_factions; ++faction_i)
+	{
+		uint16_t count = tested.bag[faction_i] + tested.attack_zone[faction_i] + tested.rally_zone[faction_i];
+		for (auto hexagon_i = 0; hexagon_i < default_nb_hexagons; ++hexagon_i)
+		{
+			count += tested.hexagons[hexagon_i][faction_i];
+		}
+		for (auto hand_i = 0; hand_i < default_nb_hands; ++hand_i)
+		{
+			count += tested.hands[hand_i][faction_i];
+		}
+		assert(count == default_nb_per_faction);
+	}
+}
+
+void test_move_codec(void)
+{
+	using Codec = DefaultGameStateType::CorrespondingMoveCodec;
+
+	for (MoveId move = 0; move < Codec::NB_MOVES; ++move)
+	{
+		const auto order = Codec::decode(move);
+		assert(order.is_valid());
+		assert(Codec::get_order_type(move) == order.order_type);
+		assert(Codec::encode(order) == move);
+	}
+}
+
+// returns whether the checked method accepts the move, state is left untouched
+bool is_accepted_by_checked_method(const DefaultGameStateType &tested, const uint8_t hand_idx, const MoveId move)
+{
+	auto copy = tested;
+	const auto order = DefaultGameStateType::CorrespondingMoveCodec::decode(move);
+	switch(order.order_type)
+	{
+		case ATTACK:
+			return copy.attack(hand_idx, order.atking_faction_idx, order.atked_faction_idx, order.nb_atked_units, order.hexagon_idx);
+		case DEPLOY:
+			return copy.deploy(hand_idx, order.faction_idx, order.hexagon_idx);
+		case RALLY:
+			return copy.rally(hand_idx, order.faction_idx, order.nb_units, order.start_hexagon_idx, order.end_hexagon_idx);
+		case NEGOCIATE:
+		default:
+			return copy.can_negociate();
+	}
+}
+
+void test_generate_legal_moves(void)
+{
+	for (auto seed = 0; seed < 20; ++seed)
+	{
+		INITIALIZE_DEFAULT_GAMESTATE(, tested, seed)
+
+		std::mt19937 move_picker(seed);
+		uint8_t hand_idx = 0;
+		DefaultGameStateType::MoveBuffer moves;
+
+		while(tested.successive_negociation_counter != default_nb_hands)
+		{
+			const auto nb_moves = tested.generate_legal_moves(hand_idx, moves);
+			assert(nb_moves > 0);
+			assert(nb_moves <= DefaultGameStateType::MAX_LEGAL_MOVES);
+
+			// exactly the moves accepted by attack, rally, deploy and negociate are generated, once each
+			std::vector<bool> is_generated(DefaultGameStateType::NB_MOVES, false);
+			for (MoveId move_i = 0; move_i < nb_moves; ++move_i)
+			{
+				assert(!is_generated[moves[move_i]]);
+				is_generated[moves[move_i]] = true;
+			}
+			for (MoveId move = 0; move < DefaultGameStateType::NB_MOVES; ++move)
+			{
+				assert(is_generated[move] == is_accepted_by_checked_method(tested, hand_idx, move));
+				assert(is_generated[move] == tested.is_legal(hand_idx, move));
+			}
+			assert(!tested.is_legal(hand_idx, DefaultGameStateType::NB_MOVES));
+
+			// apply gives the same result as the checked methods
+			const auto chosen_move = moves[move_picker() % nb_moves];
+			if(DefaultGameStateType::CorrespondingMoveCodec::get_order_type(chosen_move) != NEGOCIATE)
+			{
+				auto checked = tested;
+				const auto order = DefaultGameStateType::CorrespondingMoveCodec::decode(chosen_move);
+				switch(order.order_type)
+				{
+					case ATTACK:
+						assert(checked.attack(hand_idx, order.atking_faction_idx, order.atked_faction_idx, order.nb_atked_units, order.hexagon_idx));
+						break;
+					case DEPLOY:
+						assert(checked.deploy(hand_idx, order.faction_idx, order.hexagon_idx));
+						break;
+					case RALLY:
+						assert(checked.rally(hand_idx, order.faction_idx, order.nb_units, order.start_hexagon_idx, order.end_hexagon_idx));
+						break;
+					default:
+						break;
+				}
+				assert(tested.apply(hand_idx, chosen_move, discard_first_in_hand));
+				assert(0 == ::memcmp(&tested, &checked, sizeof(tested)));
+			}
+			else
+			{
+				assert(tested.apply(hand_idx, chosen_move, discard_first_in_hand));
+			}
+
+			assert_units_are_conserved(tested);
+
+			++hand_idx;
+			hand_idx *= (hand_idx < default_nb_hands);
+		}
+	}
+}
+
+void test_snapshot_memory_usage(void)
+{
+	constexpr auto snapshot_size = sizeof(DefaultGameStateType::Snapshot);
+	constexpr auto undo_record_size = sizeof(DefaultGameStateType::UndoRecord);
+
+	std::cerr << "[INFO] default snapshot memory usage is " << snapshot_size << " bytes." << std::endl;
+	std::cerr << "[INFO] default undo record memory usage is " << undo_record_size << " bytes." << std::endl;
+
+	assert(snapshot_size < MAX_ALLOWED_SNAPSHOT_SIZE);
+	assert(undo_record_size < MAX_ALLOWED_UNDO_RECORD_SIZE);
+}
+
+void test_copies_do_not_share_random_generator(void)
+{
+	INITIALIZE_DEFAULT_GAMESTATE(, tested, time(nullptr))
+
+	auto copy = tested;
+	while(tested.total_in_bag() > 0)
+	{
+		assert(tested.draw_random_from_bag() == copy.draw_random_from_bag());
+	}
+}
+
+void test_snapshot_restore(void)
+{
+	INITIALIZE_DEFAULT_GAMESTATE(, tested, time(nullptr))
+
+	const auto snapshot = tested.snapshot();
+	const auto sealed_copy = tested;
+
+	DefaultGameStateType::MoveBuffer moves;
+	uint8_t hand_idx = 0;
+	while(tested.successive_negociation_counter != default_nb_hands)
+	{
+		const auto nb_moves = tested.generate_legal_moves(hand_idx, moves);
+		tested.make_move(hand_idx, moves[tested.random_generator.uniform(nb_moves)], discard_first_in_hand);
+
+		++hand_idx;
+		hand_idx *= (hand_idx < default_nb_hands);
+	}
+	tested.get_winning_hand();
+
+	tested.restore(snapshot);
+	assert(0 == ::memcmp(&tested, &sealed_copy, sizeof(tested)));
+}
+
+void test_make_unmake_move(void)
+{
+	for (auto seed = 0; seed < 50; ++seed)
+	{
+		INITIALIZE_DEFAULT_GAMESTATE(, tested, seed)
+
+		DefaultGameStateType::MoveBuffer moves;
+		std::vector<DefaultGameStateType::UndoRecord> undo_records;
+		std::vector<DefaultGameStateType> previous_states;
+		uint8_t hand_idx = 0;
+
+		auto sometimes_failing_picker = [seed](const std::array<uint8_t, default_nb_factions>& hand)
+		{
+			return (seed % 7 == 0) ? (uint8_t)0 : discard_first_in_hand(hand);
+		};
+
+		while(tested.successive_negociation_counter != default_nb_hands && undo_records.size() < 200)
+		{
+			const auto nb_moves = tested.generate_legal_moves(hand_idx, moves);
+			const auto move = moves[(seed + undo_records.size()) % nb_moves];
+
+			// make_move behaves like apply
+			auto applied = tested;
+			applied.apply(hand_idx, move, sometimes_failing_picker);
+
+			previous_states.push_back(tested);
+			undo_records.push_back(tested.make_move(hand_idx, move, sometimes_failing_picker));
+			assert(0 == ::memcmp(&tested, &applied, sizeof(tested)));
+			assert_units_are_conserved(tested);
+
+			++hand_idx;
+			hand_idx *= (hand_idx < default_nb_hands);
+		}
+
+		// unmaking everything goes back through every previous state
+		while(!undo_records.empty())
+		{
+			tested.unmake_move(undo_records.back());
+			assert(0 == ::memcmp(&tested, &previous_states.back(), sizeof(tested)));
+
+			undo_records.pop_back();
+			previous_states.pop_back();
+		}
+	}
+}
+
+// with an empty bag a negociation has nothing to draw, it is a no-op which unmake_move reverts as such
+void test_make_move_negociate_empty_bag(void)
+{
+	INITIALIZE_DEFAULT_GAMESTATE(, tested, 0)
+
+	while(tested.total_in_bag() > 0)
+	{
+		tested.draw_random_from_bag();
+	}
+	const auto before = tested;
+
+	const auto undo_record = tested.make_move(0, DefaultGameStateType::CorrespondingMoveCodec::encode_negociate(), discard_first_in_hand);
+	assert(undo_record.discarded_faction_idx == default_nb_factions);
+	assert(0 == ::memcmp(&tested, &before, sizeof(tested)));
+
+	tested.unmake_move(undo_record);
+	assert(0 == ::memcmp(&tested, &before, sizeof(tested)));
+}
+
+void test_incremental_hash(void)
+{
+	for (auto seed = 0; seed < 50; ++seed)
+	{
+		INITIALIZE_DEFAULT_GAMESTATE(, tested, seed)
+		assert(tested.get_hash() == tested.compute_hash());
+
+		DefaultGameStateType::MoveBuffer moves;
+		uint8_t hand_idx = 0;
+		while(tested.successive_negociation_counter != default_nb_hands)
+		{
+			const auto previous_hash = tested.get_hash();
+			const auto nb_moves = tested.generate_legal_moves(hand_idx, moves);
+			const auto undo_record = tested.make_move(hand_idx, moves[(seed * 31 + hand_idx) % nb_moves], discard_first_in_hand);
+			assert(tested.get_hash() == tested.compute_hash());
+
+			tested.unmake_move(undo_record);
+			assert(tested.get_hash() == previous_hash);
+
+			tested.apply(hand_idx, moves[tested.random_generator.uniform(nb_moves)], discard_first_in_hand);
+			assert(tested.get_hash() == tested.compute_hash());
+
+			++hand_idx;
+			hand_idx *= (hand_idx < default_nb_hands);
+		}
+	}
+}
+
+void test_hash_transpositions(void)
+{
+	INITIALIZE_DEFAULT_GAMESTATE(, tested, time(nullptr))
+
+	tested.hands[0] = {2, 1, 1};
+	tested.recompute_hash();
+	const auto initial_hash = tested.get_hash();
+
+	auto first_order = tested;
+	assert(first_order.deploy(0, 0, 3));
+	assert(first_order.deploy(0, 1, 5));
+
+	auto second_order = tested;
+	assert(second_order.deploy(0, 1, 5));
+	assert(second_order.deploy(0, 0, 3));
+
+	assert(first_order.get_hash() == second_order.get_hash());
+	assert(first_order.get_hash() != initial_hash);
+	assert(first_order.get_hash() == first_order.compute_hash());
+
+	auto other_position = tested;
+	assert(other_position.deploy(0, 0, 5));
+	assert(other_position.deploy(0, 1, 3));
+	assert(other_position.get_hash() != first_order.get_hash());
+}
+
+void test_board_topology(void)
+{
+	using TopologyType = DefaultGameStateType::CorrespondingBoardTopology;
+
+	static_assert(sizeof(TopologyType) == (default_nb_hexagons + 1) * sizeof(uint16_t));
+	static_assert(default_board_topology.are_adjacent(0, 1) && default_board_topology.are_adjacent(1, 0));
+	static_assert(!default_board_topology.is_reachable(7));
+
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+	fill_default_adjacency_graph(adjacency_graph);
+	const auto tested = TopologyType::from_adjacency_graph(adjacency_graph, default_unreachable_hexagons);
+
+	assert(tested == default_board_topology);
+	for (uint8_t first_hexagon_i = 0; first_hexagon_i < default_nb_hexagons; ++first_hexagon_i)
+	{
+		assert(tested.is_reachable(first_hexagon_i) == (default_unreachable_hexagons.count(first_hexagon_i) == 0));
+		for (uint8_t second_hexagon_i = 0; second_hexagon_i < default_nb_hexagons; ++second_hexagon_i)
+		{
+			const bool adjacent = adjacency_graph[first_hexagon_i][second_hexagon_i];
+			assert(tested.are_adjacent(first_hexagon_i, second_hexagon_i) == adjacent);
+			assert(
+				(bool)((tested.get_reachable_neighbors(first_hexagon_i) >> second_hexagon_i) & 1)
+				== (adjacent && tested.is_reachable(second_hexagon_i))
+			);
+		}
+	}
+
+	// both constructors build the same game
+	const std::array<uint8_t, default_nb_factions> factions_starting_point = {{2, 6, 11}};
+	for (uint64_t seed = 0; seed < 16; ++seed)
+	{
+		const auto from_pointers = DefaultGameStateType(
+			&adjacency_graph,
+			&factions_starting_point,
+			&default_unreachable_hexagons,
+			seed
+		);
+		const auto from_topology = DefaultGameStateType(default_board_topology, &factions_starting_point, seed);
+		assert(from_pointers.topology == from_topology.topology);
+		assert(from_pointers.hexagons == from_topology.hexagons);
+		assert(from_pointers.hands == from_topology.hands);
+		assert(from_pointers.bag == from_topology.bag);
+		assert(from_pointers.get_hash() == from_topology.get_hash());
+		assert(from_pointers.random_generator.state == from_topology.random_generator.state);
+	}
+}
+
 void test_gamestate(void)
 {
 	test_gamestate_constructor();
@@ -569,6 +912,16 @@ void test_gamestate(void)
 	test_rally();
 	test_attack();
 	test_get_winning_hand();
+	test_move_codec();
+	test_generate_legal_moves();
+	test_snapshot_memory_usage();
+	test_copies_do_not_share_random_generator();
+	test_snapshot_restore();
+	test_make_unmake_move();
+	test_make_move_negociate_empty_bag();
+	test_incremental_hash();
+	test_hash_transpositions();
+	test_board_topology();
 }
 
 #endif // GAMESTATE_TEST_HXX
\ No newline at end of file
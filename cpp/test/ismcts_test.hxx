@@ -0,0 +1,233 @@
+#pragma once
+#ifndef ISMCTS_TEST_HXX
+#define ISMCTS_TEST_HXX
+
+#include <map>
+
+#include "test.hxx"
+#include "gamestate_test.hxx"
+#include "gamehandler_test.hxx"
+#include "../src/ismcts.hxx"
+
+using namespace Turncoat;
+
+using DefaultISMCTSType = ISMCTS<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units
+  >;
+
+DefaultGameViewType get_game_view(const DefaultGameStateType &game_state, const uint8_t hand_idx)
+{
+	std::array<uint8_t, default_nb_hands> hand_sizes = {0};
+	for (uint8_t hand_i = 0; hand_i < default_nb_hands; ++hand_i)
+	{
+		for (const auto nb_units : game_state.hands[hand_i])
+		{
+			hand_sizes[hand_i] += nb_units;
+		}
+	}
+
+	return DefaultGameViewType(
+		game_state.attack_zone,
+		game_state.rally_zone,
+		game_state.hands[hand_idx],
+		game_state.hexagons,
+		hand_sizes,
+		hand_idx,
+		game_state.successive_negociation_counter
+	);
+}
+
+// plays nb_moves random legal moves, returns the hand to play next
+uint8_t play_random_moves(DefaultGameStateType &game_state, const uint32_t nb_moves, SplitMix64 &random_generator)
+{
+	DefaultGameStateType::MoveBuffer moves;
+	uint8_t hand_idx = 0;
+	for (uint32_t move_i = 0; move_i < nb_moves && game_state.successive_negociation_counter < default_nb_hands; ++move_i)
+	{
+		const auto nb_legal_moves = game_state.generate_legal_moves(hand_idx, moves);
+		if(nb_legal_moves == 0)
+		{
+			break;
+		}
+		game_state.make_move(hand_idx, moves[random_generator.uniform(nb_legal_moves)], discard_first_in_hand);
+
+		++hand_idx;
+		hand_idx *= (hand_idx < default_nb_hands);
+	}
+	return hand_idx;
+}
+
+void test_ismcts_determinize(void)
+{
+	INITIALIZE_DEFAULT_GAMESTATE(, game_state, 1)
+	SplitMix64 moves_random_generator{1};
+	const uint8_t hand_idx = play_random_moves(game_state, 12, moves_random_generator);
+	const auto game_view = get_game_view(game_state, hand_idx);
+
+	const DefaultISMCTSType tested(default_board_topology, default_factions_starting_point, ISMCTSConfig());
+
+	bool has_sampled_other_hands = false;
+	for (uint32_t sample_i = 0; sample_i < 100; ++sample_i)
+	{
+		const auto sample = tested.determinize(game_view, moves_random_generator);
+		assert(sample.hexagons == game_state.hexagons);
+		assert(sample.attack_zone == game_state.attack_zone);
+		assert(sample.rally_zone == game_state.rally_zone);
+		assert(sample.hands[hand_idx] == game_state.hands[hand_idx]);
+		assert(sample.successive_negociation_counter == game_state.successive_negociation_counter);
+
+		uint32_t nb_in_bag = 0;
+		uint32_t nb_in_real_bag = 0;
+		for (uint8_t faction_i = 0; faction_i < default_nb_factions; ++faction_i)
+		{
+			nb_in_bag += sample.bag[faction_i];
+			nb_in_real_bag += game_state.bag[faction_i];
+		}
+		assert(nb_in_bag == nb_in_real_bag);
+
+		for (uint8_t hand_i = 0; hand_i < default_nb_hands; ++hand_i)
+		{
+			uint32_t hand_size = 0;
+			for (const auto nb_units : sample.hands[hand_i])
+			{
+				hand_size += nb_units;
+			}
+			assert(hand_size == game_view.hand_sizes[hand_i]);
+			has_sampled_other_hands |= (sample.hands[hand_i] != game_state.hands[hand_i]);
+		}
+
+		auto sampled_state = game_state;
+		sampled_state.restore(sample);
+		assert_units_are_conserved(sampled_state);
+	}
+	assert(has_sampled_other_hands);
+}
+
+void test_ismcts_search(void)
+{
+	INITIALIZE_DEFAULT_GAMESTATE(, game_state, 2)
+	SplitMix64 moves_random_generator{2};
+	const uint8_t hand_idx = play_random_moves(game_state, 8, moves_random_generator);
+	const auto game_view = get_game_view(game_state, hand_idx);
+
+	DefaultGameStateType::MoveBuffer moves;
+	const auto nb_legal_moves = game_state.generate_legal_moves(hand_idx, moves);
+	auto is_legal = [&moves, nb_legal_moves](const MoveId move){
+		return std::find(moves.begin(), moves.begin() + nb_legal_moves, move) != moves.begin() + nb_legal_moves;
+	};
+
+	ISMCTSConfig config;
+	config.nb_iterations = 300;
+	config.seed = 3;
+
+	// same seed, same budget, same move
+	DefaultISMCTSType first(default_board_topology, default_factions_starting_point, config);
+	DefaultISMCTSType second(default_board_topology, default_factions_starting_point, config);
+	const auto first_move = first.search(game_view);
+	assert(is_legal(first_move));
+	assert(first_move == second.search(game_view));
+	assert(first.get_nb_iterations() == config.nb_iterations);
+
+	uint64_t nb_root_visits = 0;
+	for (const auto &root_child : first.get_root_children(0))
+	{
+		assert(is_legal(root_child.move));
+		assert(root_child.hand_idx == hand_idx);
+		nb_root_visits += root_child.nb_visits;
+	}
+	assert(nb_root_visits == config.nb_iterations);
+
+	// the budget is split among threads
+	config.nb_threads = 3;
+	DefaultISMCTSType threaded(default_board_topology, default_factions_starting_point, config);
+	const auto threaded_move = threaded.search(game_view);
+	assert(is_legal(threaded_move));
+	assert(threaded.get_nb_iterations() == config.nb_iterations);
+
+	// and the most visited move over every thread is picked
+	std::map<MoveId, uint64_t> nb_visits_per_move;
+	for (uint32_t worker_i = 0; worker_i < config.nb_threads; ++worker_i)
+	{
+		for (const auto &root_child : threaded.get_root_children(worker_i))
+		{
+			nb_visits_per_move[root_child.move] += root_child.nb_visits;
+		}
+	}
+	for (const auto &[move, nb_visits] : nb_visits_per_move)
+	{
+		assert(nb_visits <= nb_visits_per_move[threaded_move]);
+	}
+
+	// time budget only
+	config.nb_iterations = 0;
+	config.time_budget_ms = 20;
+	DefaultISMCTSType timed(default_board_topology, default_factions_starting_point, config);
+	assert(is_legal(timed.search(game_view)));
+	assert(timed.get_nb_iterations() > 0);
+}
+
+// through GameHandler, against hands which always negociate (which beat random play), from every seat
+void test_ismcts_beats_negociation(void)
+{
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+	fill_default_adjacency_graph(adjacency_graph);
+
+	const std::function<DefaultOrderType(const DefaultGameViewType)> always_order_negociate = (
+		[](const DefaultGameViewType){return DefaultOrderType();}
+	);
+	const std::function<uint8_t(const std::array<uint8_t, default_nb_factions>&)> discard_first_possible = (
+		[](const std::array<uint8_t, default_nb_factions> &hand){return discard_first_in_hand(hand);}
+	);
+
+	const uint32_t nb_games = 24;
+	uint32_t nb_wins = 0;
+	for (uint32_t game_i = 0; game_i < nb_games; ++game_i)
+	{
+		ISMCTSConfig config;
+		config.nb_iterations = 500;
+		config.seed = game_i;
+		DefaultISMCTSType searcher(default_board_topology, default_factions_starting_point, config);
+
+		const uint8_t searcher_hand_idx = game_i % default_nb_hands;
+		std::array<std::function<DefaultOrderType(const DefaultGameViewType)>, default_nb_hands> order_getters;
+		std::array<std::function<uint8_t(const std::array<uint8_t, default_nb_factions>&)>, default_nb_hands> discarded_faction_pickers;
+		order_getters.fill(always_order_negociate);
+		discarded_faction_pickers.fill(discard_first_possible);
+		order_getters[searcher_hand_idx] = [&searcher](const DefaultGameViewType game_view){
+			return searcher.get_order(game_view);
+		};
+		discarded_faction_pickers[searcher_hand_idx] = [&searcher](const std::array<uint8_t, default_nb_factions> &hand){
+			return searcher.pick_discarded_faction(hand);
+		};
+
+		auto game_handler = DefaultGameHandlerType(
+			&adjacency_graph,
+			&default_factions_starting_point,
+			&default_unreachable_hexagons,
+			(uint64_t)game_i,
+			order_getters,
+			discarded_faction_pickers
+		);
+		game_handler.run_all_turns();
+		nb_wins += (game_handler.get_winner() == searcher_hand_idx);
+	}
+
+	std::cerr << "[INFO] ismcts won " << nb_wins << " of " << nb_games << " games against negociation." << std::endl;
+
+	// a quarter is what a hand as good as the others gets
+	assert(nb_wins > nb_games / default_nb_hands + 2);
+}
+
+void test_ismcts(void)
+{
+	test_ismcts_determinize();
+	test_ismcts_search();
+	test_ismcts_beats_negociation();
+}
+
+#endif // ISMCTS_TEST_HXX
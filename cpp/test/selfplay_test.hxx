@@ -0,0 +1,139 @@
+#pragma once
+#ifndef SELFPLAY_TEST_HXX
+#define SELFPLAY_TEST_HXX
+
+#include <stdexcept>
+
+#include "test.hxx"
+#include "../src/selfplay.hxx"
+
+using namespace Turncoat;
+
+using DefaultSelfPlayRunnerType = SelfPlayRunner<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units
+  >;
+
+#ifndef INITIALIZE_DEFAULT_SELFPLAYRUNNER
+#define INITIALIZE_DEFAULT_SELFPLAYRUNNER(VarName)											\
+																						\
+std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;	\
+fill_default_adjacency_graph(adjacency_graph);											\
+																						\
+const DefaultSelfPlayRunnerType VarName(												\
+	adjacency_graph,																	\
+	default_factions_starting_point,													\
+	default_unreachable_hexagons,														\
+	DefaultSelfPlayRunnerType::get_builtin_policies()									\
+);
+#endif // INITIALIZE_DEFAULT_SELFPLAYRUNNER
+
+void assert_same_results(const SelfPlayResults &first, const SelfPlayResults &second)
+{
+	assert(first.nb_games == second.nb_games);
+	assert(first.nb_turns == second.nb_turns);
+	assert(first.policies.size() == second.policies.size());
+	for (size_t policy_i = 0; policy_i < first.policies.size(); ++policy_i)
+	{
+		assert(first.policies[policy_i].nb_games == second.policies[policy_i].nb_games);
+		assert(first.policies[policy_i].nb_seats == second.policies[policy_i].nb_seats);
+		assert(first.policies[policy_i].nb_wins == second.policies[policy_i].nb_wins);
+	}
+}
+
+void test_selfplay_results_are_consistent(void)
+{
+	INITIALIZE_DEFAULT_SELFPLAYRUNNER(tested)
+
+	const uint64_t nb_games = 1001;
+	const auto results = tested.run(nb_games, 42, 2, 16);
+
+	assert(results.nb_games == nb_games);
+	assert(results.nb_turns >= nb_games * default_nb_hands);
+
+	uint64_t nb_seats = 0;
+	uint64_t nb_wins = 0;
+	for (const auto &policy : results.policies)
+	{
+		nb_seats += policy.nb_seats;
+		nb_wins += policy.nb_wins;
+
+		// both builtin policies take part in every game
+		assert(policy.nb_games == nb_games);
+
+		const auto confidence_interval = policy.get_confidence_interval();
+		assert(confidence_interval[0] <= policy.get_win_rate());
+		assert(policy.get_win_rate() <= confidence_interval[1]);
+	}
+	assert(nb_seats == nb_games * default_nb_hands);
+	assert(nb_wins == nb_games);
+}
+
+void test_selfplay_is_independent_of_threads(void)
+{
+	INITIALIZE_DEFAULT_SELFPLAYRUNNER(tested)
+
+	const uint64_t nb_games = 500;
+	const auto reference = tested.run(nb_games, 1234, 1);
+
+	assert_same_results(reference, tested.run(nb_games, 1234, 3, 7));
+	assert_same_results(reference, tested.run(nb_games, 1234, 8, 1));
+
+	// and another seed plays other games
+	const auto other = tested.run(nb_games, 4321, 1);
+	assert(other.nb_turns != reference.nb_turns);
+}
+
+void test_selfplay_game_is_reproducible(void)
+{
+	INITIALIZE_DEFAULT_SELFPLAYRUNNER(tested)
+
+	for (uint64_t game_idx = 0; game_idx < 50; ++game_idx)
+	{
+		uint64_t first_nb_turns = 0;
+		uint64_t second_nb_turns = 0;
+		assert(tested.play_game(7, game_idx, first_nb_turns) == tested.play_game(7, game_idx, second_nb_turns));
+		assert(first_nb_turns == second_nb_turns);
+	}
+}
+
+void test_selfplay_rejects_invalid_policies(void)
+{
+	bool has_thrown = false;
+	try
+	{
+		DefaultSelfPlayRunnerType::get_builtin_policy("unknown");
+	}
+	catch(const std::invalid_argument &)
+	{
+		has_thrown = true;
+	}
+	assert(has_thrown);
+
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+	fill_default_adjacency_graph(adjacency_graph);
+	has_thrown = false;
+	try
+	{
+		const DefaultSelfPlayRunnerType tested(adjacency_graph, default_factions_starting_point, default_unreachable_hexagons, {});
+	}
+	catch(const std::invalid_argument &)
+	{
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+void test_selfplay(void)
+{
+	test_selfplay_results_are_consistent();
+	test_selfplay_is_independent_of_threads();
+	test_selfplay_game_is_reproducible();
+	test_selfplay_rejects_invalid_policies();
+}
+
+#endif // SELFPLAY_TEST_HXX
@@ -0,0 +1,189 @@
+#pragma once
+#ifndef STATICGAMEHANDLER_TEST_HXX
+#define STATICGAMEHANDLER_TEST_HXX
+
+#include "test.hxx"
+#include "gamestate_test.hxx"
+#include "gamehandler_test.hxx"
+#include "ismcts_test.hxx"
+#include "../src/ismcts.hxx"
+#include "../src/staticgamehandler.hxx"
+
+using namespace Turncoat;
+
+using DefaultGameStateViewType = GameStateView<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units
+  >;
+
+struct NegociatePolicy
+{
+	DefaultOrderType get_order(const DefaultGameStateViewType &)
+	{
+		return DefaultOrderType();
+	}
+
+	uint8_t pick_discarded_faction(const std::array<uint8_t, default_nb_factions> &hand)
+	{
+		return discard_first_in_hand(hand);
+	}
+};
+
+// also checks that the view shows what the game view would
+struct RandomLegalPolicy
+{
+	SplitMix64 random_generator;
+	DefaultGameStateType::MoveBuffer moves{}; // scratch, so that policies can be built from their generator only
+
+	DefaultOrderType get_order(const DefaultGameStateViewType &game_state_view)
+	{
+		const auto game_view = game_state_view.to_game_view();
+		assert(game_view.hand == game_state_view.get_hand());
+		assert(game_view.hexagons == game_state_view.get_hexagons());
+		assert(game_view.hand_idx == game_state_view.get_hand_idx());
+		assert(game_view.hand_sizes[game_view.hand_idx] == game_state_view.get_hand_size(game_view.hand_idx));
+
+		const auto nb_moves = game_state_view.generate_legal_moves(this->moves);
+		if(nb_moves == 0)
+		{
+			return DefaultOrderType();
+		}
+		return DefaultGameStateType::CorrespondingMoveCodec::decode(this->moves[this->random_generator.uniform(nb_moves)]);
+	}
+
+	uint8_t pick_discarded_faction(const std::array<uint8_t, default_nb_factions> &hand)
+	{
+		return discard_first_in_hand(hand);
+	}
+};
+
+using NegociateStaticGameHandlerType = UniformStaticGameHandler<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units,
+  	NegociatePolicy
+  >;
+
+using RandomStaticGameHandlerType = UniformStaticGameHandler<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units,
+  	RandomLegalPolicy
+  >;
+
+void test_staticgamehandler_matches_gamehandler(void)
+{
+	std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;
+	fill_default_adjacency_graph(adjacency_graph);
+
+	const std::function<DefaultOrderType(const DefaultGameViewType)> always_order_negociate = (
+		[](const DefaultGameViewType){return DefaultOrderType();}
+	);
+	const std::function<uint8_t(const std::array<uint8_t, default_nb_factions>&)> discard_first_possible = (
+		[](const std::array<uint8_t, default_nb_factions> &hand){return discard_first_in_hand(hand);}
+	);
+	std::array<std::function<DefaultOrderType(const DefaultGameViewType)>, default_nb_hands> order_getters;
+	std::array<std::function<uint8_t(const std::array<uint8_t, default_nb_factions>&)>, default_nb_hands> discarded_faction_pickers;
+	order_getters.fill(always_order_negociate);
+	discarded_faction_pickers.fill(discard_first_possible);
+
+	for (uint64_t seed = 0; seed < 100; ++seed)
+	{
+		auto reference = DefaultGameHandlerType(
+			&adjacency_graph,
+			&default_factions_starting_point,
+			&default_unreachable_hexagons,
+			seed,
+			order_getters,
+			discarded_faction_pickers
+		);
+		auto tested = NegociateStaticGameHandlerType(
+			default_board_topology,
+			&default_factions_starting_point,
+			seed,
+			{}
+		);
+
+		reference.run_all_turns();
+		tested.run_all_turns();
+
+		assert(tested.game_state.hands == reference.game_state.hands);
+		assert(tested.game_state.bag == reference.game_state.bag);
+		assert(tested.game_state.get_hash() == reference.game_state.get_hash());
+		assert(tested.get_winner() == reference.get_winner());
+	}
+}
+
+void test_staticgamehandler_random_games(void)
+{
+	for (uint64_t seed = 0; seed < 100; ++seed)
+	{
+		auto tested = RandomStaticGameHandlerType(
+			default_board_topology,
+			&default_factions_starting_point,
+			seed,
+			{
+				RandomLegalPolicy{SplitMix64{seed}.split(0)},
+				RandomLegalPolicy{SplitMix64{seed}.split(1)},
+				RandomLegalPolicy{SplitMix64{seed}.split(2)},
+				RandomLegalPolicy{SplitMix64{seed}.split(3)}
+			}
+		);
+
+		while(tested.game_state.get_successive_negociation_counter() < default_nb_hands)
+		{
+			assert(tested.run_turn());
+			assert_units_are_conserved(tested.game_state);
+		}
+		assert(tested.get_winner() < default_nb_hands);
+	}
+}
+
+// policies given as references stay with the caller
+void test_staticgamehandler_reference_policy(void)
+{
+	ISMCTSConfig config;
+	config.nb_iterations = 50;
+	DefaultISMCTSType searcher(default_board_topology, default_factions_starting_point, config);
+
+	auto tested = StaticGameHandler<
+		default_nb_hexagons,
+		default_nb_factions,
+		default_nb_per_faction,
+		default_nb_hands,
+		default_nb_per_hand,
+		default_nb_starting_units,
+		DefaultISMCTSType&,
+		NegociatePolicy,
+		NegociatePolicy,
+		NegociatePolicy
+	>(
+		default_board_topology,
+		&default_factions_starting_point,
+		0,
+		{searcher, {}, {}, {}}
+	);
+
+	assert(tested.run_turn());
+	assert(searcher.get_nb_iterations() == config.nb_iterations);
+	tested.run_all_turns();
+}
+
+void test_staticgamehandler(void)
+{
+	test_staticgamehandler_matches_gamehandler();
+	test_staticgamehandler_random_games();
+	test_staticgamehandler_reference_policy();
+}
+
+#endif // STATICGAMEHANDLER_TEST_HXX
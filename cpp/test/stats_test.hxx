@@ -0,0 +1,165 @@
+#pragma once
+#ifndef STATS_TEST_HXX
+#define STATS_TEST_HXX
+
+#include <thread>
+#include <vector>
+
+#include "test.hxx"
+#include "gamestate_test.hxx"
+#include "staticgamehandler_test.hxx"
+#include "../src/stats.hxx"
+
+using namespace Turncoat;
+
+void test_stats_negociation_game(void)
+{
+	reset_stats();
+	auto handler = NegociateStaticGameHandlerType(
+		default_board_topology,
+		&default_factions_starting_point,
+		0,
+		{}
+	);
+	// setting up the game is not counted
+	assert(get_stats().get(BAG_DRAWS) == 0);
+
+	handler.run_all_turns();
+
+	const auto stats = get_stats();
+	assert(stats.get(GAMES) == 1);
+	assert(stats.get(TURNS) == default_nb_hands);
+	assert(stats.get(BAG_DRAWS) == default_nb_hands);
+	assert(stats.negociation_streaks[default_nb_hands] == 1);
+	assert(stats.get_average_negociation_streak() == default_nb_hands);
+	assert(stats.get_average_game_length() == default_nb_hands);
+	for (const auto order_type : {ATTACK, DEPLOY, NEGOCIATE, RALLY})
+	{
+		assert(stats.get_nb_failed_orders(order_type) == 0);
+	}
+}
+
+void test_stats_failed_orders(void)
+{
+	INITIALIZE_DEFAULT_GAMESTATE(, tested, 0)
+	reset_stats();
+
+	// 7 is unreachable
+	assert(!tested.attack(0, 0, 0, 0, 2));
+	assert(!tested.rally(0, 0, 1, 7, 2));
+	assert(!tested.negociate(0, [](const std::array<uint8_t, default_nb_factions> &){return default_nb_factions;}));
+	tested.add_to_hand(0, 0, -tested.hands[0][0]);
+	assert(!tested.deploy(0, 0, 2));
+	assert(!tested.deploy(0, 0, 3));
+
+	auto stats = get_stats();
+	assert(stats.get_nb_failed_orders(ATTACK) == 1);
+	assert(stats.get_nb_failed_orders(RALLY) == 1);
+	assert(stats.get_nb_failed_orders(NEGOCIATE) == 1);
+	assert(stats.get_nb_failed_orders(DEPLOY) == 2);
+	assert(stats.get(TURNS) == 0);
+	assert(stats.get(BAG_DRAWS) == 1); // the failed negociation drew before putting back
+
+	// a streak of one, broken by a deploy
+	assert(tested.negociate(1, discard_first_in_hand));
+	assert(tested.deploy(2, discard_first_in_hand(tested.hands[2]), 2));
+	stats = get_stats();
+	assert(stats.get(TURNS) == 2);
+	assert(stats.negociation_streaks[1] == 1);
+	assert(stats.get(GAMES) == 0);
+}
+
+// what finished threads counted is kept
+void test_stats_threads(void)
+{
+	constexpr uint64_t nb_threads = 4;
+	constexpr uint64_t nb_games_per_thread = 25;
+
+	reset_stats();
+	std::vector<std::thread> threads;
+	for (uint64_t thread_i = 0; thread_i < nb_threads; ++thread_i)
+	{
+		threads.emplace_back([thread_i](){
+			for (uint64_t game_i = 0; game_i < nb_games_per_thread; ++game_i)
+			{
+				auto handler = NegociateStaticGameHandlerType(
+					default_board_topology,
+					&default_factions_starting_point,
+					thread_i * nb_games_per_thread + game_i,
+					{}
+				);
+				handler.run_all_turns();
+			}
+		});
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	const auto stats = get_stats();
+	assert(stats.get(GAMES) == nb_threads * nb_games_per_thread);
+	assert(stats.get(TURNS) == nb_threads * nb_games_per_thread * default_nb_hands);
+	assert(stats.get(BAG_DRAWS) == nb_threads * nb_games_per_thread * default_nb_hands);
+}
+
+// what search plays and takes back through make_move is not counted
+void test_stats_search_is_not_counted(void)
+{
+	INITIALIZE_DEFAULT_GAMESTATE(, game_state, 3)
+	SplitMix64 moves_random_generator{3};
+	const uint8_t hand_idx = play_random_moves(game_state, 4, moves_random_generator);
+
+	ISMCTSConfig config;
+	config.nb_iterations = 200;
+	config.nb_threads = 2;
+	DefaultISMCTSType searcher(default_board_topology, default_factions_starting_point, config);
+
+	reset_stats();
+	searcher.search(get_game_view(game_state, hand_idx));
+
+	const auto stats = get_stats();
+	assert(stats.get(GAMES) == 0);
+	assert(stats.get(TURNS) == 0);
+	assert(stats.get(BAG_DRAWS) == 0);
+	assert(stats.get_average_negociation_streak() == 0.);
+}
+
+// the default build, every TURNCOAT_COUNT compiles to nothing
+void test_stats_are_off(void)
+{
+	auto handler = NegociateStaticGameHandlerType(
+		default_board_topology,
+		&default_factions_starting_point,
+		0,
+		{}
+	);
+	handler.run_all_turns();
+
+	const auto stats = get_stats();
+	for (const auto nb_counted : stats.counters)
+	{
+		assert(nb_counted == 0);
+	}
+	for (const auto nb_streaks : stats.negociation_streaks)
+	{
+		assert(nb_streaks == 0);
+	}
+}
+
+// counted by stats_test.cpp only, built with -DTURNCOAT_STATS, main_test.cpp checks the default build
+void test_stats(void)
+{
+	if constexpr (!STATS_ENABLED)
+	{
+		test_stats_are_off();
+		return;
+	}
+
+	test_stats_negociation_game();
+	test_stats_failed_orders();
+	test_stats_threads();
+	test_stats_search_is_not_counted();
+}
+
+#endif // STATS_TEST_HXX
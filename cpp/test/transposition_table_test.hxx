@@ -0,0 +1,113 @@
+#pragma once
+#ifndef TRANSPOSITION_TABLE_TEST_HXX
+#define TRANSPOSITION_TABLE_TEST_HXX
+
+#include <thread>
+#include <vector>
+
+#include "test.hxx"
+#include "../src/transposition_table.hxx"
+
+using namespace Turncoat;
+
+void test_transposition_table_memory_usage(void)
+{
+	TranspositionTable tested(10);
+
+	assert(sizeof(TranspositionTable::Bucket) == 64);
+	assert(alignof(TranspositionTable::Bucket) == 64);
+	assert(((uintptr_t)tested.buckets.get()) % 64 == 0);
+	assert(tested.get_nb_entries() == 1024 * TranspositionTable::NB_ENTRIES_PER_BUCKET);
+}
+
+void test_transposition_table_probe_update(void)
+{
+	TranspositionTable tested(4);
+	TranspositionStats stats;
+
+	const uint64_t key = 0xDEADBEEF12345678ULL;
+	assert(!tested.probe(key, stats));
+
+	tested.update(key, 1.f);
+	tested.update(key, 0.f);
+	tested.update(key, 1.f, 2);
+
+	assert(tested.probe(key, stats));
+	assert(stats.nb_visits == 4);
+	assert(stats.total_value == 2.f);
+	assert(stats.mean_value() == .5f);
+
+	tested.clear();
+	assert(!tested.probe(key, stats));
+}
+
+void test_transposition_table_replacement(void)
+{
+	TranspositionTable tested(2);
+	TranspositionStats stats;
+
+	// all these keys land in bucket 1, the least visited one gets evicted
+	const uint64_t bucket_idx = 1;
+	for (uint64_t entry_i = 0; entry_i < TranspositionTable::NB_ENTRIES_PER_BUCKET; ++entry_i)
+	{
+		tested.update(((entry_i + 1) << 8) | bucket_idx, 0.f, 10 + entry_i);
+	}
+
+	const uint64_t new_key = (0xFFULL << 8) | bucket_idx;
+	tested.update(new_key, 1.f);
+
+	assert(tested.probe(new_key, stats));
+	assert(stats.nb_visits == 1);
+	assert(!tested.probe((1 << 8) | bucket_idx, stats));
+	for (uint64_t entry_i = 1; entry_i < TranspositionTable::NB_ENTRIES_PER_BUCKET; ++entry_i)
+	{
+		assert(tested.probe(((entry_i + 1) << 8) | bucket_idx, stats));
+		assert(stats.nb_visits == 10 + entry_i);
+	}
+}
+
+void test_transposition_table_concurrent_updates(void)
+{
+	TranspositionTable tested(6);
+
+	const uint8_t nb_threads = 4;
+	const uint32_t nb_updates = 100000;
+	const uint64_t nb_keys = 64;
+
+	std::vector<std::thread> threads;
+	for (uint8_t thread_i = 0; thread_i < nb_threads; ++thread_i)
+	{
+		threads.emplace_back([&tested, thread_i](){
+			for (uint32_t update_i = 0; update_i < nb_updates; ++update_i)
+			{
+				const uint64_t key = ((update_i + thread_i) % nb_keys) * 0x9E3779B97F4A7C15ULL;
+				tested.update(key, 1.f);
+			}
+		});
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	// increments can be lost under contention, but whatever is found must be consistent
+	for (uint64_t key_i = 0; key_i < nb_keys; ++key_i)
+	{
+		TranspositionStats stats;
+		if(tested.probe(key_i * 0x9E3779B97F4A7C15ULL, stats))
+		{
+			assert(stats.nb_visits <= nb_threads * nb_updates);
+			assert(stats.total_value == (float)stats.nb_visits);
+		}
+	}
+}
+
+void test_transposition_table(void)
+{
+	test_transposition_table_memory_usage();
+	test_transposition_table_probe_update();
+	test_transposition_table_replacement();
+	test_transposition_table_concurrent_updates();
+}
+
+#endif // TRANSPOSITION_TABLE_TEST_HXX
@@ -0,0 +1,303 @@
+#pragma once
+#ifndef VECGAMEENV_TEST_HXX
+#define VECGAMEENV_TEST_HXX
+
+#include <stdexcept>
+#include <vector>
+
+#include "test.hxx"
+#include "../src/vecgameenv.hxx"
+
+using namespace Turncoat;
+
+using DefaultVecGameEnvType = VecGameEnv<
+  	default_nb_hexagons,
+  	default_nb_factions,
+  	default_nb_per_faction,
+  	default_nb_hands,
+  	default_nb_per_hand,
+  	default_nb_starting_units
+  >;
+
+#ifndef INITIALIZE_DEFAULT_VECGAMEENV
+#define INITIALIZE_DEFAULT_VECGAMEENV(VarName, NbEnvs)										\
+																						\
+std::array<std::array<bool, default_nb_hexagons>, default_nb_hexagons> adjacency_graph;	\
+fill_default_adjacency_graph(adjacency_graph);											\
+																						\
+std::vector<uint64_t> seeds(NbEnvs);													\
+for (uint32_t env_i = 0; env_i < NbEnvs; ++env_i)										\
+{																						\
+	seeds[env_i] = env_i;																\
+}																						\
+																						\
+DefaultVecGameEnvType VarName(															\
+	NbEnvs,																				\
+	seeds,																				\
+	adjacency_graph,																	\
+	{{2, 6, 11}},																		\
+	{7}																					\
+);
+#endif // INITIALIZE_DEFAULT_VECGAMEENV
+
+// picks the k-th legal action of each env, k depending on the step
+void pick_legal_actions(const DefaultVecGameEnvType &env, const uint32_t step_i, std::vector<uint32_t> &actions)
+{
+	for (uint32_t env_i = 0; env_i < env.nb_envs; ++env_i)
+	{
+		assert(env.nb_legal_actions[env_i] > 0);
+		actions[env_i] = env.legal_actions[env_i][(step_i * 7 + env_i) % env.nb_legal_actions[env_i]];
+	}
+}
+
+// whether the mask of every env holds its legal actions and nothing else
+bool do_masks_match_legal_actions(const DefaultVecGameEnvType &env)
+{
+	for (uint32_t env_i = 0; env_i < env.nb_envs; ++env_i)
+	{
+		const uint8_t *legal_action_mask = &env.legal_action_masks[(size_t)env_i * DefaultVecGameEnvType::NB_ACTIONS];
+
+		uint32_t nb_masked_actions = 0;
+		for (uint32_t action = 0; action < DefaultVecGameEnvType::NB_ACTIONS; ++action)
+		{
+			nb_masked_actions += legal_action_mask[action];
+		}
+		if(nb_masked_actions != env.nb_legal_actions[env_i])
+		{
+			return false;
+		}
+
+		for (MoveId action_i = 0; action_i < env.nb_legal_actions[env_i]; ++action_i)
+		{
+			if(!legal_action_mask[env.legal_actions[env_i][action_i]])
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void test_vecgameenv_units_are_conserved(void)
+{
+	const uint32_t nb_envs = 16;
+	INITIALIZE_DEFAULT_VECGAMEENV(tested, nb_envs)
+
+	std::vector<uint32_t> actions(nb_envs);
+	uint32_t nb_dones = 0;
+
+	for (uint32_t step_i = 0; step_i < 2000; ++step_i)
+	{
+		pick_legal_actions(tested, step_i, actions);
+		assert(tested.step(actions.data()) == 0);
+
+		for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+		{
+			for (auto faction_i = 0; faction_i < default_nb_factions; ++faction_i)
+			{
+				uint16_t count = (
+					tested.bag[env_i * default_nb_factions + faction_i]
+					+ tested.attack_zone[env_i * default_nb_factions + faction_i]
+					+ tested.rally_zone[env_i * default_nb_factions + faction_i]
+				);
+				for (auto hexagon_i = 0; hexagon_i < default_nb_hexagons; ++hexagon_i)
+				{
+					count += tested.hexagons[(env_i * default_nb_hexagons + hexagon_i) * default_nb_factions + faction_i];
+				}
+				for (auto hand_i = 0; hand_i < default_nb_hands; ++hand_i)
+				{
+					count += tested.hands[(env_i * default_nb_hands + hand_i) * default_nb_factions + faction_i];
+				}
+				assert(count == default_nb_per_faction);
+			}
+
+			// exactly one winner per finished game
+			float total_reward = 0.f;
+			for (auto hand_i = 0; hand_i < default_nb_hands; ++hand_i)
+			{
+				total_reward += tested.rewards[env_i * default_nb_hands + hand_i];
+			}
+			assert(total_reward == (tested.dones[env_i] ? 1.f : 0.f));
+			nb_dones += tested.dones[env_i];
+		}
+	}
+
+	assert(nb_dones > 0);
+}
+
+void test_vecgameenv_matches_gamestate(void)
+{
+	const uint32_t nb_envs = 4;
+	INITIALIZE_DEFAULT_VECGAMEENV(tested, nb_envs)
+
+	// env 0 is replayed on a standalone GameState seeded the same way
+	const std::array<uint8_t, default_nb_factions> factions_starting_point = {{2, 6, 11}};
+	const std::unordered_set<uint8_t> unreachable_hexagons{7};
+	auto reference = DefaultGameStateType(
+		&adjacency_graph,
+		&factions_starting_point,
+		&unreachable_hexagons,
+		tested.get_game_seed(0)
+	);
+
+	std::vector<uint32_t> actions(nb_envs);
+	uint8_t reference_player_idx = 0;
+	DefaultGameStateType::MoveBuffer moves;
+
+	for (uint32_t step_i = 0; !tested.dones[0]; ++step_i)
+	{
+		assert(0 == ::memcmp(&tested.hexagons[0], &reference.hexagons, sizeof(reference.hexagons)));
+		assert(0 == ::memcmp(&tested.hands[0], &reference.hands, sizeof(reference.hands)));
+		assert(0 == ::memcmp(&tested.bag[0], &reference.bag, sizeof(reference.bag)));
+		assert(tested.current_player_idx[0] == reference_player_idx);
+
+		if(!tested.pending_discard[0])
+		{
+			const auto nb_moves = reference.generate_legal_moves(reference_player_idx, moves);
+			assert(tested.nb_legal_actions[0] == nb_moves);
+			for (MoveId move_i = 0; move_i < nb_moves; ++move_i)
+			{
+				assert(tested.legal_actions[0][move_i] == moves[move_i]);
+			}
+		}
+
+		pick_legal_actions(tested, step_i, actions);
+		const auto action = actions[0];
+		tested.step(actions.data());
+
+		if(action >= DefaultVecGameEnvType::DISCARD_OFFSET)
+		{
+			assert(reference.discard_for_negociation(reference_player_idx, action - DefaultVecGameEnvType::DISCARD_OFFSET));
+		}
+		else if(DefaultGameStateType::CorrespondingMoveCodec::get_order_type(action) == NEGOCIATE)
+		{
+			reference.draw_for_negociation(reference_player_idx);
+			continue;
+		}
+		else
+		{
+			assert(reference.apply(reference_player_idx, action, discard_first_in_hand));
+		}
+
+		++reference_player_idx;
+		reference_player_idx *= (reference_player_idx < default_nb_hands);
+	}
+
+	assert(reference.successive_negociation_counter == default_nb_hands);
+	assert(tested.rewards[reference.get_winning_hand()] == 1.f);
+	assert(tested.nb_finished_games[0] == 1);
+}
+
+void test_vecgameenv_illegal_action_is_ignored(void)
+{
+	const uint32_t nb_envs = 2;
+	INITIALIZE_DEFAULT_VECGAMEENV(tested, nb_envs)
+
+	const auto sealed_hexagons = tested.hexagons;
+	const auto sealed_hands = tested.hands;
+
+	// discarding without having negociated is never legal
+	std::vector<uint32_t> actions(nb_envs, DefaultVecGameEnvType::DISCARD_OFFSET);
+	assert(tested.step(actions.data()) == nb_envs);
+
+	// neither is a move absent from the legal actions
+	tested.write_legal_action_masks();
+	for (uint32_t env_i = 0; env_i < nb_envs; ++env_i)
+	{
+		const uint8_t *legal_action_mask = &tested.legal_action_masks[(size_t)env_i * DefaultVecGameEnvType::NB_ACTIONS];
+		actions[env_i] = DefaultVecGameEnvType::DISCARD_OFFSET - 1;
+		while(legal_action_mask[actions[env_i]])
+		{
+			--actions[env_i];
+		}
+	}
+	assert(tested.step(actions.data()) == nb_envs);
+
+	actions.assign(nb_envs, DefaultVecGameEnvType::NB_ACTIONS);
+	assert(tested.step(actions.data()) == nb_envs);
+
+	assert(tested.hexagons == sealed_hexagons);
+	assert(tested.hands == sealed_hands);
+	assert(tested.current_player_idx[0] == 0);
+}
+
+void test_vecgameenv_is_deterministic(void)
+{
+	const uint32_t nb_envs = 8;
+	INITIALIZE_DEFAULT_VECGAMEENV(first, nb_envs)
+	DefaultVecGameEnvType second(nb_envs, seeds, adjacency_graph, {{2, 6, 11}}, {7});
+
+	std::vector<uint32_t> actions(nb_envs);
+	for (uint32_t step_i = 0; step_i < 500; ++step_i)
+	{
+		pick_legal_actions(first, step_i, actions);
+		first.step(actions.data());
+		second.step(actions.data());
+
+		assert(first.observations == second.observations);
+		assert(first.nb_legal_actions == second.nb_legal_actions);
+		assert(first.legal_actions == second.legal_actions);
+		assert(first.rewards == second.rewards);
+	}
+}
+
+// masks written every few steps only, so that some envs are stepped or reset several times in between
+void test_vecgameenv_masks_match_legal_actions(void)
+{
+	const uint32_t nb_envs = 8;
+	INITIALIZE_DEFAULT_VECGAMEENV(tested, nb_envs)
+
+	assert(tested.write_legal_action_masks() == nb_envs);
+	assert(do_masks_match_legal_actions(tested));
+	assert(tested.write_legal_action_masks() == 0);
+
+	std::vector<uint32_t> actions(nb_envs);
+	for (uint32_t step_i = 0; step_i < 600; ++step_i)
+	{
+		pick_legal_actions(tested, step_i, actions);
+		// the last env only plays every other step
+		if(step_i % 2)
+		{
+			actions[nb_envs - 1] = DefaultVecGameEnvType::NB_ACTIONS;
+		}
+		tested.step(actions.data());
+
+		if(step_i % 3 == 2)
+		{
+			assert(tested.write_legal_action_masks() == nb_envs);
+			assert(do_masks_match_legal_actions(tested));
+		}
+	}
+
+	actions.assign(nb_envs, DefaultVecGameEnvType::NB_ACTIONS);
+	tested.step(actions.data());
+	assert(tested.write_legal_action_masks() == 0);
+}
+
+void test_vecgameenv_rejects_missing_seeds(void)
+{
+	INITIALIZE_DEFAULT_VECGAMEENV(valid, 2)
+
+	bool has_thrown = false;
+	try
+	{
+		DefaultVecGameEnvType tested(3, seeds, adjacency_graph, {{2, 6, 11}}, {7});
+	}
+	catch(const std::invalid_argument &)
+	{
+		has_thrown = true;
+	}
+	assert(has_thrown);
+}
+
+void test_vecgameenv(void)
+{
+	test_vecgameenv_units_are_conserved();
+	test_vecgameenv_matches_gamestate();
+	test_vecgameenv_illegal_action_is_ignored();
+	test_vecgameenv_is_deterministic();
+	test_vecgameenv_masks_match_legal_actions();
+	test_vecgameenv_rejects_missing_seeds();
+}
+
+#endif // VECGAMEENV_TEST_HXX